@@ -2,6 +2,7 @@
 #include "S_UI_Settings.h"
 #include "Engine/AssetManager.h"
 #include "Data/S_UI_ScreenDataAsset.h"
+#include "UObject/UObjectGlobals.h"
 
 void US_UI_AssetManager::Initialize(const US_UI_Settings* InSettings)
 {
@@ -131,4 +132,21 @@ TSubclassOf<UCommonActivatableWidget> US_UI_AssetManager::GetScreenWidgetClass(E
         return *FoundClass;
     }
     return nullptr;
+}
+
+void US_UI_AssetManager::KeepLoadedUntilNextMap(TSharedPtr<FStreamableHandle> Handle)
+{
+    if (!Handle.IsValid())
+    {
+        return;
+    }
+
+    // The handle rides along on a one-shot PostLoadMap binding
+    TSharedRef<FDelegateHandle> PostLoadMapHandle = MakeShared<FDelegateHandle>();
+    *PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddLambda(
+        [Handle, PostLoadMapHandle](UWorld*)
+        {
+            Handle->ReleaseHandle();
+            FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(*PostLoadMapHandle);
+        });
 }
\ No newline at end of file
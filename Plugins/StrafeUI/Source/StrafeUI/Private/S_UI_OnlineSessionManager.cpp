@@ -1,16 +1,99 @@
 // Plugins/StrafeUI/Source/StrafeUI/Private/S_UI_OnlineSessionManager.cpp
 
 #include "S_UI_OnlineSessionManager.h"
+#include "S_UI_Settings.h"
+#include "Services/S_JoinTrace.h"
 #include "OnlineSubsystem.h"
 #include "OnlineSessionSettings.h"
 #include "Engine/World.h"
 #include "Engine/GameInstance.h"
 #include "GameFramework/PlayerController.h"
+#include "Algo/AnyOf.h"
+#include "UObject/UObjectGlobals.h"
 
 // Define custom session settings keys
 #define SETTING_MAPNAME FName(TEXT("MAPNAME"))
 #define SETTING_GAMENAME FName(TEXT("GAMENAME"))
 
+namespace S_OnlineSessionManager
+{
+    /** Seconds between timeout checks while a step is running */
+    constexpr float TimeoutCheckIntervalSeconds = 0.25f;
+
+    /** Static step names; also the join trace phase names */
+    const TCHAR* GetStepName(E_SessionStepType Type)
+    {
+        switch (Type)
+        {
+        case E_SessionStepType::Find:       return TEXT("FindSessions");
+        case E_SessionStepType::FindById:   return TEXT("FindSessionById");
+        case E_SessionStepType::Join:       return TEXT("JoinSession");
+        case E_SessionStepType::Create:     return TEXT("CreateSession");
+        case E_SessionStepType::Start:      return TEXT("StartSession");
+        case E_SessionStepType::Update:     return TEXT("UpdateSession");
+        case E_SessionStepType::End:        return TEXT("EndSession");
+        case E_SessionStepType::Destroy:    return TEXT("DestroySession");
+        }
+        return TEXT("Unknown");
+    }
+
+    const TCHAR* GetResultName(E_SessionOperationResult Result)
+    {
+        switch (Result)
+        {
+        case E_SessionOperationResult::Succeeded:   return TEXT("succeeded");
+        case E_SessionOperationResult::Failed:      return TEXT("failed");
+        case E_SessionOperationResult::TimedOut:    return TEXT("timed out");
+        case E_SessionOperationResult::Cancelled:   return TEXT("was cancelled");
+        case E_SessionOperationResult::Superseded:  return TEXT("was superseded");
+        }
+        return TEXT("ended");
+    }
+}
+
+F_SessionStep F_SessionStep::Make(E_SessionStepType Type)
+{
+    F_SessionStep Step;
+    Step.Type = Type;
+    return Step;
+}
+
+F_SessionStep F_SessionStep::MakeFind(const TSharedRef<FOnlineSessionSearch>& Search)
+{
+    F_SessionStep Step = Make(E_SessionStepType::Find);
+    Step.Search = Search;
+    return Step;
+}
+
+F_SessionStep F_SessionStep::MakeFindById(const FUniqueNetIdRef& SessionId, const FUniqueNetIdPtr& FriendId)
+{
+    F_SessionStep Step = Make(E_SessionStepType::FindById);
+    Step.SessionId = SessionId;
+    Step.FriendId = FriendId;
+    return Step;
+}
+
+F_SessionStep F_SessionStep::MakeJoin(const FOnlineSessionSearchResult& SearchResult)
+{
+    F_SessionStep Step = Make(E_SessionStepType::Join);
+    Step.SearchResult = SearchResult;
+    return Step;
+}
+
+F_SessionStep F_SessionStep::MakeCreate(const TSharedRef<FOnlineSessionSettings>& Settings)
+{
+    F_SessionStep Step = Make(E_SessionStepType::Create);
+    Step.Settings = Settings;
+    return Step;
+}
+
+F_SessionStep F_SessionStep::MakeUpdate(const TSharedRef<FOnlineSessionSettings>& Settings)
+{
+    F_SessionStep Step = Make(E_SessionStepType::Update);
+    Step.Settings = Settings;
+    return Step;
+}
+
 void US_UI_OnlineSessionManager::Initialize()
 {
     // Cache the session interface
@@ -21,14 +104,49 @@ void US_UI_OnlineSessionManager::Initialize()
     }
 
     CurrentSessionName = NAME_GameSession;
+
+    PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddUObject(this, &US_UI_OnlineSessionManager::OnPostLoadMap);
 }
 
 void US_UI_OnlineSessionManager::Shutdown()
 {
-    ClearAllDelegates();
+    FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+    PostLoadMapHandle.Reset();
+
+    // Unsent setting changes are dropped with the session
+    if (SettingsFlushTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(SettingsFlushTickerHandle);
+        SettingsFlushTickerHandle.Reset();
+    }
+    PendingSettingChanges.Reset();
+
+    if (TimeoutTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(TimeoutTickerHandle);
+        TimeoutTickerHandle.Reset();
+    }
+
+    // Stop listening for running steps and report everything still queued as cancelled
+    TArray<F_PendingOperation> Abandoned;
+    for (TPair<FName, TUniquePtr<F_OperationQueue>>& Pair : Queues)
+    {
+        F_OperationQueue& Queue = *Pair.Value;
+        if (Queue.bStepRunning)
+        {
+            AbortStep(Queue);
+            Queue.bStepRunning = false;
+        }
+        Abandoned.Append(MoveTemp(Queue.Operations));
+        Queue.Operations.Reset();
+    }
+    for (F_PendingOperation& Operation : Abandoned)
+    {
+        ReportOperation(Operation, E_SessionOperationResult::Cancelled);
+    }
 
     // If we're in a session, try to destroy it
-    if (IsInSession() && !bIsDestroyingSession)
+    if (IsInSession())
     {
         DestroyCurrentSession();
     }
@@ -36,12 +154,24 @@ void US_UI_OnlineSessionManager::Shutdown()
 
 bool US_UI_OnlineSessionManager::IsInSession() const
 {
-    if (!CachedSessionInterface.IsValid())
+    IOnlineSessionPtr SessionInterface = GetSessionInterface(CurrentSessionSubsystemName);
+    if (!SessionInterface.IsValid())
     {
         return false;
     }
 
-    return CachedSessionInterface->GetNamedSession(CurrentSessionName) != nullptr;
+    return SessionInterface->GetNamedSession(CurrentSessionName) != nullptr;
+}
+
+FName US_UI_OnlineSessionManager::GetLANSubsystemName()
+{
+    // Online backends run one search at a time and advertise LAN games their own way, so LAN goes through the NULL subsystem next to them
+    IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get();
+    if (OnlineSubsystem && OnlineSubsystem->GetSubsystemName() != NULL_SUBSYSTEM && IOnlineSubsystem::Get(NULL_SUBSYSTEM))
+    {
+        return NULL_SUBSYSTEM;
+    }
+    return NAME_None;
 }
 
 IOnlineSessionPtr US_UI_OnlineSessionManager::GetSessionInterface() const
@@ -61,74 +191,64 @@ IOnlineSessionPtr US_UI_OnlineSessionManager::GetSessionInterface() const
     return nullptr;
 }
 
-void US_UI_OnlineSessionManager::DestroyCurrentSession()
+IOnlineSessionPtr US_UI_OnlineSessionManager::GetSessionInterface(FName SubsystemName) const
 {
-    if (!CachedSessionInterface.IsValid() || bIsDestroyingSession)
+    if (const TUniquePtr<F_OperationQueue>* Queue = Queues.Find(SubsystemName))
     {
-        return;
+        return (*Queue)->SessionInterface;
     }
 
-    if (!IsInSession())
+    if (SubsystemName.IsNone())
     {
-        UE_LOG(LogTemp, Warning, TEXT("DestroyCurrentSession called but no session exists"));
-        return;
+        return GetSessionInterface();
     }
 
-    bIsDestroyingSession = true;
-
-    // Bind the destroy complete delegate
-    DestroySessionCompleteDelegateHandle = CachedSessionInterface->AddOnDestroySessionCompleteDelegate_Handle(
-        FOnDestroySessionCompleteDelegate::CreateUObject(this, &US_UI_OnlineSessionManager::OnDestroySessionComplete)
-    );
-
-    // Destroy the session
-    if (!CachedSessionInterface->DestroySession(CurrentSessionName))
-    {
-        UE_LOG(LogTemp, Error, TEXT("Failed to destroy session"));
-
-        // Clean up since we won't get a callback
-        CachedSessionInterface->ClearOnDestroySessionCompleteDelegate_Handle(DestroySessionCompleteDelegateHandle);
-        bIsDestroyingSession = false;
-    }
+    IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get(SubsystemName);
+    return OnlineSubsystem ? OnlineSubsystem->GetSessionInterface() : nullptr;
 }
 
-void US_UI_OnlineSessionManager::LeaveSession()
+void US_UI_OnlineSessionManager::DestroyCurrentSession()
 {
-    if (!CachedSessionInterface.IsValid())
+    if (!IsInSession())
     {
+        UE_LOG(LogTemp, Warning, TEXT("DestroyCurrentSession called but no session exists"));
         return;
     }
 
+    F_SessionOperation Operation;
+    Operation.DebugName = TEXT("Destroy session");
+    Operation.SubsystemName = CurrentSessionSubsystemName;
+    Operation.SessionName = CurrentSessionName;
+    Operation.Steps.Add(F_SessionStep::Make(E_SessionStepType::Destroy));
+    Operation.CoalesceKey = TEXT("DestroySession");
+    Operation.OnComplete.BindUObject(this, &US_UI_OnlineSessionManager::OnDestroySessionComplete);
+    SubmitOperation(MoveTemp(Operation));
+}
+
+void US_UI_OnlineSessionManager::LeaveSession()
+{
     if (!IsInSession())
     {
         UE_LOG(LogTemp, Warning, TEXT("LeaveSession called but no session exists"));
         return;
     }
 
-    // For clients, we end the session rather than destroy it
-    EndSessionCompleteDelegateHandle = CachedSessionInterface->AddOnEndSessionCompleteDelegate_Handle(
-        FOnEndSessionCompleteDelegate::CreateUObject(this, &US_UI_OnlineSessionManager::OnEndSessionComplete)
-    );
-
-    if (!CachedSessionInterface->EndSession(CurrentSessionName))
-    {
-        UE_LOG(LogTemp, Error, TEXT("Failed to end session"));
-
-        // Clean up since we won't get a callback
-        CachedSessionInterface->ClearOnEndSessionCompleteDelegate_Handle(EndSessionCompleteDelegateHandle);
-    }
+    // For clients, we end the session before destroying it
+    F_SessionOperation Operation;
+    Operation.DebugName = TEXT("Leave session");
+    Operation.SubsystemName = CurrentSessionSubsystemName;
+    Operation.SessionName = CurrentSessionName;
+    Operation.Steps.Add(F_SessionStep::Make(E_SessionStepType::End));
+    Operation.Steps.Add(F_SessionStep::Make(E_SessionStepType::Destroy));
+    Operation.CoalesceKey = TEXT("DestroySession");
+    Operation.OnComplete.BindUObject(this, &US_UI_OnlineSessionManager::OnDestroySessionComplete);
+    SubmitOperation(MoveTemp(Operation));
 }
 
 void US_UI_OnlineSessionManager::RegisterSession(const FString& ServerName, const FString& MapName, int32 MaxPlayers)
 {
-    if (!CachedSessionInterface.IsValid())
-    {
-        UE_LOG(LogTemp, Error, TEXT("No session interface available"));
-        return;
-    }
-
     // Create session settings for dedicated server
-    TSharedPtr<FOnlineSessionSettings> SessionSettings = MakeShareable(new FOnlineSessionSettings());
+    TSharedRef<FOnlineSessionSettings> SessionSettings = MakeShared<FOnlineSessionSettings>();
 
     SessionSettings->NumPublicConnections = MaxPlayers;
     SessionSettings->NumPrivateConnections = 0;
@@ -144,155 +264,686 @@ void US_UI_OnlineSessionManager::RegisterSession(const FString& ServerName, cons
     SessionSettings->Set(SETTING_GAMENAME, ServerName, EOnlineDataAdvertisementType::ViaOnlineService);
     SessionSettings->Set(SETTING_MAPNAME, MapName, EOnlineDataAdvertisementType::ViaOnlineService);
 
-    // Bind completion delegate
-    RegisterSessionCompleteDelegateHandle = CachedSessionInterface->AddOnCreateSessionCompleteDelegate_Handle(
-        FOnCreateSessionCompleteDelegate::CreateUObject(this, &US_UI_OnlineSessionManager::OnRegisterSessionComplete)
-    );
+    F_SessionOperation Operation;
+    Operation.DebugName = TEXT("Register dedicated server session");
+    Operation.SessionName = CurrentSessionName;
+    Operation.Steps.Add(F_SessionStep::MakeCreate(SessionSettings));
+    Operation.OnComplete.BindUObject(this, &US_UI_OnlineSessionManager::OnRegisterSessionComplete);
+    SubmitOperation(MoveTemp(Operation));
+}
 
-    // Create the session
-    if (!CachedSessionInterface->CreateSession(0, CurrentSessionName, *SessionSettings))
+void US_UI_OnlineSessionManager::UpdateSessionSettings(const TMap<FName, FString>& NewSettings)
+{
+    IOnlineSessionPtr SessionInterface = GetSessionInterface(CurrentSessionSubsystemName);
+    if (!SessionInterface.IsValid() || !IsInSession())
     {
-        UE_LOG(LogTemp, Error, TEXT("Failed to register dedicated server session"));
+        return;
+    }
+
+    FOnlineSessionSettings* SessionSettings = SessionInterface->GetSessionSettings(CurrentSessionName);
+    if (!SessionSettings)
+    {
+        UE_LOG(LogTemp, Error, TEXT("Failed to get session settings for update"));
+        return;
+    }
+
+    // Merge into the pending changes; a value the backend already has cancels any pending change of it.
+    // The live settings hold values a failed update never delivered, so they are only trusted for settings never changed here.
+    bool bMapChanged = false;
+    for (const auto& Setting : NewSettings)
+    {
+        FString CurrentValue;
+        const bool bChangedHere = GetAdvertisedSetting(Setting.Key, CurrentValue);
+        if ((bChangedHere || SessionSettings->Get(Setting.Key, CurrentValue)) && CurrentValue == Setting.Value)
+        {
+            PendingSettingChanges.Remove(Setting.Key);
+
+            // Undo any undelivered value in the live settings, so the next update does not carry it along
+            if (bChangedHere)
+            {
+                SessionSettings->Set(Setting.Key, Setting.Value, EOnlineDataAdvertisementType::ViaOnlineService);
+            }
+            continue;
+        }
+
+        PendingSettingChanges.Add(Setting.Key, Setting.Value);
+        bMapChanged |= Setting.Key == SETTING_MAPNAME;
+    }
+
+    if (PendingSettingChanges.Num() == 0)
+    {
+        return;
+    }
 
-        // Clean up
-        CachedSessionInterface->ClearOnCreateSessionCompleteDelegate_Handle(RegisterSessionCompleteDelegateHandle);
+    // Browsers filter and join by map, so a new map is not held back
+    if (bMapChanged)
+    {
+        FlushSessionSettings();
+    }
+    else
+    {
+        ScheduleSettingsFlush(true);
     }
 }
 
-void US_UI_OnlineSessionManager::UpdateSessionSettings(const TMap<FName, FString>& NewSettings)
+void US_UI_OnlineSessionManager::ScheduleSettingsFlush(bool bAllowImmediate)
+{
+    const double SecondsUntilFlush = LastSettingsFlushSeconds + GetDefault<US_UI_Settings>()->SessionUpdateIntervalSeconds - FPlatformTime::Seconds();
+    if (bAllowImmediate && SecondsUntilFlush <= 0.0)
+    {
+        FlushSessionSettings();
+    }
+    else if (!SettingsFlushTickerHandle.IsValid())
+    {
+        SettingsFlushTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+            FTickerDelegate::CreateUObject(this, &US_UI_OnlineSessionManager::TickSettingsFlush), FMath::Max(SecondsUntilFlush, 0.0)
+        );
+    }
+}
+
+bool US_UI_OnlineSessionManager::GetAdvertisedSetting(FName Key, FString& OutValue) const
 {
-    if (!CachedSessionInterface.IsValid() || !IsInSession())
+    const FString* Value = InFlightSettingChanges.Find(Key);
+    if (!Value)
+    {
+        Value = AcknowledgedSettings.Find(Key);
+    }
+
+    if (Value)
+    {
+        OutValue = *Value;
+    }
+    return Value != nullptr;
+}
+
+void US_UI_OnlineSessionManager::ResetSettingChanges()
+{
+    if (SettingsFlushTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(SettingsFlushTickerHandle);
+        SettingsFlushTickerHandle.Reset();
+    }
+
+    PendingSettingChanges.Reset();
+    InFlightSettingChanges.Reset();
+    AcknowledgedSettings.Reset();
+}
+
+void US_UI_OnlineSessionManager::FlushSessionSettings()
+{
+    if (SettingsFlushTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(SettingsFlushTickerHandle);
+        SettingsFlushTickerHandle.Reset();
+    }
+
+    if (PendingSettingChanges.Num() == 0)
     {
         return;
     }
 
-    FOnlineSessionSettings* SessionSettings = CachedSessionInterface->GetSessionSettings(CurrentSessionName);
+    IOnlineSessionPtr SessionInterface = GetSessionInterface(CurrentSessionSubsystemName);
+    FOnlineSessionSettings* SessionSettings = SessionInterface.IsValid() ? SessionInterface->GetSessionSettings(CurrentSessionName) : nullptr;
     if (!SessionSettings)
     {
-        UE_LOG(LogTemp, Error, TEXT("Failed to get session settings for update"));
+        UE_LOG(LogTemp, Warning, TEXT("Dropping %d session setting changes; no session to update"), PendingSettingChanges.Num());
+        PendingSettingChanges.Reset();
         return;
     }
 
-    // Update the settings
-    for (const auto& Setting : NewSettings)
+    // Update the settings, remembering what the backend had in case the update never arrives
+    for (const auto& Setting : PendingSettingChanges)
     {
+        if (!AcknowledgedSettings.Contains(Setting.Key))
+        {
+            FString PreviousValue;
+            SessionSettings->Get(Setting.Key, PreviousValue);
+            AcknowledgedSettings.Add(Setting.Key, PreviousValue);
+        }
+
         SessionSettings->Set(Setting.Key, Setting.Value, EOnlineDataAdvertisementType::ViaOnlineService);
+        InFlightSettingChanges.Add(Setting.Key, Setting.Value);
+    }
+    PendingSettingChanges.Reset();
+    LastSettingsFlushSeconds = FPlatformTime::Seconds();
+
+    // The live settings accumulate every change, so a newer update makes a queued one redundant.
+    // Each update carries every change still in flight, so the one that supersedes it also answers for its values.
+    F_SessionOperation Operation;
+    Operation.DebugName = TEXT("Update session");
+    Operation.SubsystemName = CurrentSessionSubsystemName;
+    Operation.SessionName = CurrentSessionName;
+    Operation.Steps.Add(F_SessionStep::MakeUpdate(MakeShared<FOnlineSessionSettings>(*SessionSettings)));
+    Operation.CoalesceKey = TEXT("UpdateSession");
+    Operation.OnComplete.BindUObject(this, &US_UI_OnlineSessionManager::OnUpdateSessionComplete, InFlightSettingChanges);
+    SubmitOperation(MoveTemp(Operation));
+}
+
+int32 US_UI_OnlineSessionManager::SubmitOperation(F_SessionOperation&& Operation)
+{
+    F_PendingOperation Pending;
+    Pending.Id = NextOperationId++;
+    Pending.Operation = MoveTemp(Operation);
+    Pending.SubmitSeconds = FPlatformTime::Seconds();
+    Pending.Report.OperationId = Pending.Id;
+    Pending.Report.SessionName = Pending.Operation.SessionName;
+
+    F_OperationQueue* Queue = FindOrAddQueue(Pending.Operation.SubsystemName);
+    if (!Queue)
+    {
+        UE_LOG(LogTemp, Error, TEXT("Session operation '%s' has no session interface to run on"), *Pending.Operation.DebugName);
+        ReportOperation(Pending, E_SessionOperationResult::Failed);
+        return INDEX_NONE;
+    }
+
+    // Replace a queued operation with the same key; the running one is left alone
+    const FName CoalesceKey = Pending.Operation.CoalesceKey;
+    if (!CoalesceKey.IsNone())
+    {
+        for (int32 Index = 1; Index < Queue->Operations.Num(); ++Index)
+        {
+            if (Queue->Operations[Index].Operation.CoalesceKey == CoalesceKey)
+            {
+                F_PendingOperation Superseded = MoveTemp(Queue->Operations[Index]);
+                Queue->Operations[Index] = MoveTemp(Pending);
+                const int32 OperationId = Queue->Operations[Index].Id;
+
+                ReportOperation(Superseded, E_SessionOperationResult::Superseded);
+                return OperationId;
+            }
+        }
+    }
+
+    const int32 OperationId = Pending.Id;
+    Queue->Operations.Add(MoveTemp(Pending));
+    RunQueue(*Queue);
+    return OperationId;
+}
+
+void US_UI_OnlineSessionManager::CancelOperation(int32 OperationId)
+{
+    int32 Index = INDEX_NONE;
+    F_OperationQueue* Queue = FindQueueOfOperation(OperationId, Index);
+    if (!Queue)
+    {
+        return;
+    }
+
+    F_PendingOperation& Pending = Queue->Operations[Index];
+    if (Index > 0 || !Queue->bStepRunning)
+    {
+        FinishOperation(*Queue, Index, E_SessionOperationResult::Cancelled);
+        return;
+    }
+
+    // Searches can be stopped outright, which frees the queue straight away
+    if (Pending.Operation.Steps[Pending.NextStep].Type == E_SessionStepType::Find)
+    {
+        AbortStep(*Queue);
+        EndStep(*Queue, false, E_SessionOperationResult::Cancelled);
+        return;
     }
 
-    // Bind completion delegate
-    UpdateSessionCompleteDelegateHandle = CachedSessionInterface->AddOnUpdateSessionCompleteDelegate_Handle(
-        FOnUpdateSessionCompleteDelegate::CreateUObject(this, &US_UI_OnlineSessionManager::OnUpdateSessionComplete)
-    );
+    // Other calls cannot be taken back; the queue waits for the backend, but the submitter hears about it now
+    if (!Pending.bReported)
+    {
+        ReportOperation(Pending, E_SessionOperationResult::Cancelled);
+    }
+}
 
-    // Update the session
-    if (!CachedSessionInterface->UpdateSession(CurrentSessionName, *SessionSettings))
+bool US_UI_OnlineSessionManager::IsOperationPending(int32 OperationId) const
+{
+    for (const TPair<FName, TUniquePtr<F_OperationQueue>>& Pair : Queues)
     {
-        UE_LOG(LogTemp, Error, TEXT("Failed to update session"));
+        if (Pair.Value->Operations.ContainsByPredicate([OperationId](const F_PendingOperation& Pending) { return Pending.Id == OperationId && !Pending.bReported; }))
+        {
+            return true;
+        }
+    }
+    return false;
+}
 
-        // Clean up
-        CachedSessionInterface->ClearOnUpdateSessionCompleteDelegate_Handle(UpdateSessionCompleteDelegateHandle);
+US_UI_OnlineSessionManager::F_OperationQueue* US_UI_OnlineSessionManager::FindOrAddQueue(FName SubsystemName)
+{
+    if (TUniquePtr<F_OperationQueue>* Queue = Queues.Find(SubsystemName))
+    {
+        return Queue->Get();
+    }
+
+    // Resolve the interface once; callbacks never look the subsystem up again
+    IOnlineSessionPtr SessionInterface = GetSessionInterface(SubsystemName);
+    if (!SessionInterface.IsValid())
+    {
+        return nullptr;
     }
+
+    TUniquePtr<F_OperationQueue>& Queue = Queues.Add(SubsystemName, MakeUnique<F_OperationQueue>());
+    Queue->SubsystemName = SubsystemName;
+    Queue->SessionInterface = SessionInterface;
+    return Queue.Get();
 }
 
-void US_UI_OnlineSessionManager::OnDestroySessionComplete(FName SessionName, bool bWasSuccessful)
+US_UI_OnlineSessionManager::F_OperationQueue* US_UI_OnlineSessionManager::FindQueueOfOperation(int32 OperationId, int32& OutIndex)
 {
-    if (CachedSessionInterface.IsValid())
+    if (OperationId == INDEX_NONE)
+    {
+        return nullptr;
+    }
+
+    for (TPair<FName, TUniquePtr<F_OperationQueue>>& Pair : Queues)
     {
-        CachedSessionInterface->ClearOnDestroySessionCompleteDelegate_Handle(DestroySessionCompleteDelegateHandle);
+        OutIndex = Pair.Value->Operations.IndexOfByPredicate([OperationId](const F_PendingOperation& Pending) { return Pending.Id == OperationId; });
+        if (OutIndex != INDEX_NONE)
+        {
+            return Pair.Value.Get();
+        }
     }
+    return nullptr;
+}
 
-    bIsDestroyingSession = false;
+void US_UI_OnlineSessionManager::RunQueue(F_OperationQueue& Queue)
+{
+    // Steps that complete synchronously run the queue from their callback; this loop only picks up where they leave off
+    while (!Queue.bStepRunning && Queue.Operations.Num() > 0)
+    {
+        StartStep(Queue);
+    }
+}
 
-    if (bWasSuccessful)
+void US_UI_OnlineSessionManager::StartStep(F_OperationQueue& Queue)
+{
+    F_PendingOperation& Pending = Queue.Operations[0];
+    const double Now = FPlatformTime::Seconds();
+
+    if (Pending.NextStep == 0)
     {
-        UE_LOG(LogTemp, Log, TEXT("Session destroyed successfully"));
-        OnSessionStateChanged.Broadcast(false);
+        Pending.FirstStepSeconds = Now;
+        Pending.Report.QueuedSeconds = Now - Pending.SubmitSeconds;
     }
-    else
+
+    if (!Pending.Operation.Steps.IsValidIndex(Pending.NextStep))
     {
-        UE_LOG(LogTemp, Error, TEXT("Failed to destroy session"));
+        FinishOperation(Queue, 0, Pending.bReported ? E_SessionOperationResult::Cancelled : E_SessionOperationResult::Succeeded);
+        return;
+    }
+
+    const F_SessionStep& Step = Pending.Operation.Steps[Pending.NextStep];
+    const FName SessionName = Pending.Operation.SessionName;
+    const FUniqueNetIdPtr UserId = Pending.Operation.UserId;
+    IOnlineSession& Sessions = *Queue.SessionInterface;
+
+    const uint32 StepSerial = ++Queue.StepSerial;
+    Queue.bStepRunning = true;
+    Queue.StepStartSeconds = Now;
+    Queue.StepTimeoutSeconds = Step.TimeoutSeconds > 0.0f ? Step.TimeoutSeconds : GetDefault<US_UI_Settings>()->SessionOperationTimeoutSeconds;
+
+    if (!TimeoutTickerHandle.IsValid())
+    {
+        TimeoutTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+            FTickerDelegate::CreateUObject(this, &US_UI_OnlineSessionManager::TickTimeouts), S_OnlineSessionManager::TimeoutCheckIntervalSeconds
+        );
+    }
+
+    if (Pending.Operation.bTraceSteps && !Pending.bReported)
+    {
+        F_JoinTrace::BeginPhase(S_OnlineSessionManager::GetStepName(Step.Type));
+    }
+
+    // Bind the completion delegate before the call, since some subsystems complete synchronously
+    bool bStarted = false;
+    switch (Step.Type)
+    {
+    case E_SessionStepType::Find:
+        Queue.StepDelegateHandle = Sessions.AddOnFindSessionsCompleteDelegate_Handle(
+            FOnFindSessionsCompleteDelegate::CreateUObject(this, &US_UI_OnlineSessionManager::OnFindSessionsComplete, Queue.SubsystemName));
+        bStarted = Step.Search.IsValid()
+            && (UserId.IsValid() ? Sessions.FindSessions(*UserId, Step.Search.ToSharedRef()) : Sessions.FindSessions(0, Step.Search.ToSharedRef()));
+        break;
+
+    case E_SessionStepType::FindById:
+        // The delegate belongs to this call alone; the serial tells a late answer to an abandoned step apart
+        bStarted = UserId.IsValid() && Step.SessionId.IsValid()
+            && Sessions.FindSessionById(*UserId, *Step.SessionId, Step.FriendId.IsValid() ? *Step.FriendId : *UserId,
+                FOnSingleSessionResultCompleteDelegate::CreateUObject(this, &US_UI_OnlineSessionManager::OnFindSessionByIdComplete, Queue.SubsystemName, StepSerial));
+        break;
+
+    case E_SessionStepType::Join:
+        Queue.StepDelegateHandle = Sessions.AddOnJoinSessionCompleteDelegate_Handle(
+            FOnJoinSessionCompleteDelegate::CreateUObject(this, &US_UI_OnlineSessionManager::OnJoinSessionComplete, Queue.SubsystemName));
+        bStarted = UserId.IsValid() ? Sessions.JoinSession(*UserId, SessionName, Step.SearchResult) : Sessions.JoinSession(0, SessionName, Step.SearchResult);
+        break;
+
+    case E_SessionStepType::Create:
+        Queue.StepDelegateHandle = Sessions.AddOnCreateSessionCompleteDelegate_Handle(
+            FOnCreateSessionCompleteDelegate::CreateUObject(this, &US_UI_OnlineSessionManager::OnStepComplete, Queue.SubsystemName));
+        bStarted = Step.Settings.IsValid()
+            && (UserId.IsValid() ? Sessions.CreateSession(*UserId, SessionName, *Step.Settings) : Sessions.CreateSession(0, SessionName, *Step.Settings));
+        break;
+
+    case E_SessionStepType::Start:
+        Queue.StepDelegateHandle = Sessions.AddOnStartSessionCompleteDelegate_Handle(
+            FOnStartSessionCompleteDelegate::CreateUObject(this, &US_UI_OnlineSessionManager::OnStepComplete, Queue.SubsystemName));
+        bStarted = Sessions.StartSession(SessionName);
+        break;
+
+    case E_SessionStepType::Update:
+        Queue.StepDelegateHandle = Sessions.AddOnUpdateSessionCompleteDelegate_Handle(
+            FOnUpdateSessionCompleteDelegate::CreateUObject(this, &US_UI_OnlineSessionManager::OnStepComplete, Queue.SubsystemName));
+        bStarted = Step.Settings.IsValid() && Sessions.UpdateSession(SessionName, *Step.Settings);
+        break;
+
+    case E_SessionStepType::End:
+        Queue.StepDelegateHandle = Sessions.AddOnEndSessionCompleteDelegate_Handle(
+            FOnEndSessionCompleteDelegate::CreateUObject(this, &US_UI_OnlineSessionManager::OnStepComplete, Queue.SubsystemName));
+        bStarted = Sessions.EndSession(SessionName);
+        break;
+
+    case E_SessionStepType::Destroy:
+        if (!Sessions.GetNamedSession(SessionName))
+        {
+            // Nothing to destroy counts as done
+            EndStep(Queue, true, E_SessionOperationResult::Succeeded);
+            return;
+        }
+        Queue.StepDelegateHandle = Sessions.AddOnDestroySessionCompleteDelegate_Handle(
+            FOnDestroySessionCompleteDelegate::CreateUObject(this, &US_UI_OnlineSessionManager::OnStepComplete, Queue.SubsystemName));
+        bStarted = Sessions.DestroySession(SessionName);
+        break;
+    }
+
+    // A call that could not be made never calls back; unless it already did, the step fails here
+    if (!bStarted && Queue.bStepRunning && Queue.StepSerial == StepSerial)
+    {
+        UE_LOG(LogTemp, Error, TEXT("Session operation '%s' could not start %s"), *Queue.Operations[0].Operation.DebugName, S_OnlineSessionManager::GetStepName(Step.Type));
+        ClearStepDelegate(Queue);
+        EndStep(Queue, false, E_SessionOperationResult::Failed);
     }
 }
 
-void US_UI_OnlineSessionManager::OnEndSessionComplete(FName SessionName, bool bWasSuccessful)
+void US_UI_OnlineSessionManager::ClearStepDelegate(F_OperationQueue& Queue)
 {
-    if (CachedSessionInterface.IsValid())
+    if (!Queue.StepDelegateHandle.IsValid() || Queue.Operations.Num() == 0)
     {
-        CachedSessionInterface->ClearOnEndSessionCompleteDelegate_Handle(EndSessionCompleteDelegateHandle);
+        return;
     }
 
-    if (bWasSuccessful)
+    const F_PendingOperation& Pending = Queue.Operations[0];
+    IOnlineSession& Sessions = *Queue.SessionInterface;
+    switch (Pending.Operation.Steps[Pending.NextStep].Type)
     {
-        UE_LOG(LogTemp, Log, TEXT("Session ended successfully"));
+    case E_SessionStepType::Find:       Sessions.ClearOnFindSessionsCompleteDelegate_Handle(Queue.StepDelegateHandle); break;
+    case E_SessionStepType::FindById:   break;
+    case E_SessionStepType::Join:       Sessions.ClearOnJoinSessionCompleteDelegate_Handle(Queue.StepDelegateHandle); break;
+    case E_SessionStepType::Create:     Sessions.ClearOnCreateSessionCompleteDelegate_Handle(Queue.StepDelegateHandle); break;
+    case E_SessionStepType::Start:      Sessions.ClearOnStartSessionCompleteDelegate_Handle(Queue.StepDelegateHandle); break;
+    case E_SessionStepType::Update:     Sessions.ClearOnUpdateSessionCompleteDelegate_Handle(Queue.StepDelegateHandle); break;
+    case E_SessionStepType::End:        Sessions.ClearOnEndSessionCompleteDelegate_Handle(Queue.StepDelegateHandle); break;
+    case E_SessionStepType::Destroy:    Sessions.ClearOnDestroySessionCompleteDelegate_Handle(Queue.StepDelegateHandle); break;
+    }
+    Queue.StepDelegateHandle.Reset();
+}
 
-        // After ending, destroy the session
-        DestroyCurrentSession();
+void US_UI_OnlineSessionManager::AbortStep(F_OperationQueue& Queue)
+{
+    const F_PendingOperation& Pending = Queue.Operations[0];
+    const bool bIsSearch = Pending.Operation.Steps[Pending.NextStep].Type == E_SessionStepType::Find;
+
+    ClearStepDelegate(Queue);
+
+    // Frees the interface for the next search
+    if (bIsSearch)
+    {
+        Queue.SessionInterface->CancelFindSessions();
     }
-    else
+}
+
+void US_UI_OnlineSessionManager::CompleteStep(FName SubsystemName, bool bSucceeded, EOnJoinSessionCompleteResult::Type JoinResult)
+{
+    TUniquePtr<F_OperationQueue>* QueuePtr = Queues.Find(SubsystemName);
+    if (!QueuePtr || !(*QueuePtr)->bStepRunning)
     {
-        UE_LOG(LogTemp, Error, TEXT("Failed to end session"));
+        return;
     }
+
+    F_OperationQueue& Queue = **QueuePtr;
+    ClearStepDelegate(Queue);
+    Queue.Operations[0].Report.JoinResult = JoinResult;
+    EndStep(Queue, bSucceeded, E_SessionOperationResult::Failed);
 }
 
-void US_UI_OnlineSessionManager::OnRegisterSessionComplete(FName SessionName, bool bWasSuccessful)
+void US_UI_OnlineSessionManager::EndStep(F_OperationQueue& Queue, bool bSucceeded, E_SessionOperationResult FailureResult)
 {
-    if (CachedSessionInterface.IsValid())
+    F_PendingOperation& Pending = Queue.Operations[0];
+    const E_SessionStepType StepType = Pending.Operation.Steps[Pending.NextStep].Type;
+    const double StepSeconds = FPlatformTime::Seconds() - Queue.StepStartSeconds;
+
+    Queue.bStepRunning = false;
+    Pending.Report.Steps.Add({ StepType, bSucceeded, StepSeconds });
+    ++Pending.NextStep;
+
+    UE_LOG(LogTemp, Verbose, TEXT("Session operation '%s': %s %s in %.1f ms"), *Pending.Operation.DebugName,
+        S_OnlineSessionManager::GetStepName(StepType), bSucceeded ? TEXT("succeeded") : TEXT("failed"), StepSeconds * 1000.0);
+
+    // Remember which subsystem holds the session, so leaving and destroying it go to the same one
+    if (bSucceeded && Pending.Operation.SessionName == CurrentSessionName)
     {
-        CachedSessionInterface->ClearOnCreateSessionCompleteDelegate_Handle(RegisterSessionCompleteDelegateHandle);
+        if (StepType == E_SessionStepType::Join || StepType == E_SessionStepType::Create)
+        {
+            CurrentSessionSubsystemName = Queue.SubsystemName;
+            ResetSettingChanges();
+        }
+        else if (StepType == E_SessionStepType::Destroy && Queue.SubsystemName == CurrentSessionSubsystemName)
+        {
+            CurrentSessionSubsystemName = NAME_None;
+            ResetSettingChanges();
+        }
     }
 
-    if (bWasSuccessful)
+    if (Pending.bReported)
     {
-        UE_LOG(LogTemp, Log, TEXT("Dedicated server session registered successfully"));
-        OnSessionStateChanged.Broadcast(true);
+        FinishOperation(Queue, 0, E_SessionOperationResult::Cancelled);
     }
-    else
+    else if (!bSucceeded)
     {
-        UE_LOG(LogTemp, Error, TEXT("Failed to register dedicated server session"));
+        FinishOperation(Queue, 0, FailureResult);
+    }
+    else if (Pending.NextStep >= Pending.Operation.Steps.Num())
+    {
+        FinishOperation(Queue, 0, E_SessionOperationResult::Succeeded);
     }
+
+    RunQueue(Queue);
 }
 
-void US_UI_OnlineSessionManager::OnUpdateSessionComplete(FName SessionName, bool bWasSuccessful)
+void US_UI_OnlineSessionManager::FinishOperation(F_OperationQueue& Queue, int32 Index, E_SessionOperationResult Result)
 {
-    if (CachedSessionInterface.IsValid())
+    // Take the operation out first; its callback may submit more work to this queue
+    F_PendingOperation Finished = MoveTemp(Queue.Operations[Index]);
+    Queue.Operations.RemoveAt(Index);
+
+    if (!Finished.bReported)
     {
-        CachedSessionInterface->ClearOnUpdateSessionCompleteDelegate_Handle(UpdateSessionCompleteDelegateHandle);
+        ReportOperation(Finished, Result);
     }
+}
+
+void US_UI_OnlineSessionManager::ReportOperation(F_PendingOperation& Pending, E_SessionOperationResult Result)
+{
+    Pending.bReported = true;
 
-    if (bWasSuccessful)
+    F_SessionOperationReport& Report = Pending.Report;
+    Report.Result = Result;
+    Report.RunSeconds = Pending.FirstStepSeconds > 0.0 ? FPlatformTime::Seconds() - Pending.FirstStepSeconds : 0.0;
+    if (Pending.FirstStepSeconds == 0.0)
     {
-        UE_LOG(LogTemp, Log, TEXT("Session updated successfully"));
+        Report.QueuedSeconds = FPlatformTime::Seconds() - Pending.SubmitSeconds;
     }
-    else
+
+    FString StepTimes;
+    for (const F_SessionStepReport& Step : Report.Steps)
+    {
+        StepTimes += FString::Printf(TEXT("%s%s %.1f ms"), StepTimes.IsEmpty() ? TEXT("") : TEXT(", "), S_OnlineSessionManager::GetStepName(Step.Type), Step.Seconds * 1000.0);
+    }
+    UE_LOG(LogTemp, Log, TEXT("Session operation '%s' %s after %.1f ms queued, %.1f ms running (%s)"), *Pending.Operation.DebugName,
+        S_OnlineSessionManager::GetResultName(Result), Report.QueuedSeconds * 1000.0, Report.RunSeconds * 1000.0, *StepTimes);
+
+    // Unbind before calling, so a cancelled operation is never reported twice
+    FOnSessionOperationComplete OnComplete = MoveTemp(Pending.Operation.OnComplete);
+    Pending.Operation.OnComplete.Unbind();
+    OnComplete.ExecuteIfBound(Report);
+    OnOperationFinished.Broadcast(Report);
+}
+
+bool US_UI_OnlineSessionManager::TickSettingsFlush(float DeltaTime)
+{
+    SettingsFlushTickerHandle.Reset();
+    FlushSessionSettings();
+    return false;
+}
+
+void US_UI_OnlineSessionManager::OnPostLoadMap(UWorld* World)
+{
+    FlushSessionSettings();
+}
+
+bool US_UI_OnlineSessionManager::TickTimeouts(float DeltaTime)
+{
+    const double Now = FPlatformTime::Seconds();
+
+    // Collect first; failing a step runs callbacks that may add queues
+    TArray<F_OperationQueue*, TInlineAllocator<2>> TimedOut;
+    for (TPair<FName, TUniquePtr<F_OperationQueue>>& Pair : Queues)
+    {
+        F_OperationQueue& Queue = *Pair.Value;
+        if (Queue.bStepRunning && Now - Queue.StepStartSeconds >= Queue.StepTimeoutSeconds)
+        {
+            TimedOut.Add(&Queue);
+        }
+    }
+
+    for (F_OperationQueue* Queue : TimedOut)
     {
-        UE_LOG(LogTemp, Error, TEXT("Failed to update session"));
+        if (!Queue->bStepRunning)
+        {
+            continue;
+        }
+
+        const F_PendingOperation& Pending = Queue->Operations[0];
+        UE_LOG(LogTemp, Warning, TEXT("Session operation '%s' timed out in %s after %.0f s"), *Pending.Operation.DebugName,
+            S_OnlineSessionManager::GetStepName(Pending.Operation.Steps[Pending.NextStep].Type), Queue->StepTimeoutSeconds);
+
+        AbortStep(*Queue);
+        EndStep(*Queue, false, E_SessionOperationResult::TimedOut);
     }
+
+    const bool bAnyStepRunning = Algo::AnyOf(Queues, [](const TPair<FName, TUniquePtr<F_OperationQueue>>& Pair) { return Pair.Value->bStepRunning; });
+    if (!bAnyStepRunning)
+    {
+        TimeoutTickerHandle.Reset();
+        return false;
+    }
+    return true;
 }
 
-void US_UI_OnlineSessionManager::ClearAllDelegates()
+void US_UI_OnlineSessionManager::OnFindSessionsComplete(bool bWasSuccessful, FName SubsystemName)
 {
-    if (!CachedSessionInterface.IsValid())
+    CompleteStep(SubsystemName, bWasSuccessful);
+}
+
+void US_UI_OnlineSessionManager::OnFindSessionByIdComplete(int32 LocalUserNum, bool bWasSuccessful, const FOnlineSessionSearchResult& SearchResult, FName SubsystemName, uint32 StepSerial)
+{
+    const TUniquePtr<F_OperationQueue>* Queue = Queues.Find(SubsystemName);
+    if (!Queue || !(*Queue)->bStepRunning || (*Queue)->StepSerial != StepSerial)
     {
         return;
     }
 
-    if (DestroySessionCompleteDelegateHandle.IsValid())
+    (*Queue)->Operations[0].Report.FoundSession = SearchResult;
+    CompleteStep(SubsystemName, bWasSuccessful && SearchResult.IsValid());
+}
+
+void US_UI_OnlineSessionManager::OnJoinSessionComplete(FName SessionName, EOnJoinSessionCompleteResult::Type Result, FName SubsystemName)
+{
+    CompleteStep(SubsystemName, Result == EOnJoinSessionCompleteResult::Success, Result);
+}
+
+void US_UI_OnlineSessionManager::OnStepComplete(FName SessionName, bool bWasSuccessful, FName SubsystemName)
+{
+    // The completion delegates are shared with anyone else using the interface; only our session's call counts
+    const TUniquePtr<F_OperationQueue>* Queue = Queues.Find(SubsystemName);
+    if (!Queue || (*Queue)->Operations.Num() == 0 || (*Queue)->Operations[0].Operation.SessionName != SessionName)
     {
-        CachedSessionInterface->ClearOnDestroySessionCompleteDelegate_Handle(DestroySessionCompleteDelegateHandle);
+        return;
     }
 
-    if (EndSessionCompleteDelegateHandle.IsValid())
+    CompleteStep(SubsystemName, bWasSuccessful);
+}
+
+void US_UI_OnlineSessionManager::OnDestroySessionComplete(const F_SessionOperationReport& Report)
+{
+    if (Report.Succeeded())
     {
-        CachedSessionInterface->ClearOnEndSessionCompleteDelegate_Handle(EndSessionCompleteDelegateHandle);
+        UE_LOG(LogTemp, Log, TEXT("Session destroyed successfully"));
+        OnSessionStateChanged.Broadcast(false);
+    }
+    else
+    {
+        UE_LOG(LogTemp, Error, TEXT("Failed to destroy session"));
     }
+}
 
-    if (RegisterSessionCompleteDelegateHandle.IsValid())
+void US_UI_OnlineSessionManager::OnRegisterSessionComplete(const F_SessionOperationReport& Report)
+{
+    if (Report.Succeeded())
+    {
+        UE_LOG(LogTemp, Log, TEXT("Dedicated server session registered successfully"));
+        OnSessionStateChanged.Broadcast(true);
+    }
+    else
     {
-        CachedSessionInterface->ClearOnCreateSessionCompleteDelegate_Handle(RegisterSessionCompleteDelegateHandle);
+        UE_LOG(LogTemp, Error, TEXT("Failed to register dedicated server session"));
     }
+}
+
+void US_UI_OnlineSessionManager::OnUpdateSessionComplete(const F_SessionOperationReport& Report, TMap<FName, FString> FlushedChanges)
+{
+    // Superseded updates leave their values to the newer one; a cancelled one only happens on the way out
+    if (Report.Result == E_SessionOperationResult::Superseded || Report.Result == E_SessionOperationResult::Cancelled)
+    {
+        return;
+    }
+
+    for (const auto& Setting : FlushedChanges)
+    {
+        // A newer value sent since then has its own update to answer for it, and a new session starts over
+        const FString* InFlightValue = InFlightSettingChanges.Find(Setting.Key);
+        if (!InFlightValue || *InFlightValue != Setting.Value)
+        {
+            continue;
+        }
+        InFlightSettingChanges.Remove(Setting.Key);
+
+        if (Report.Succeeded())
+        {
+            AcknowledgedSettings.Add(Setting.Key, Setting.Value);
+        }
+        else if (!PendingSettingChanges.Contains(Setting.Key))
+        {
+            PendingSettingChanges.Add(Setting.Key, Setting.Value);
+        }
+    }
+
+    if (Report.Succeeded())
+    {
+        UE_LOG(LogTemp, Log, TEXT("Session updated successfully"));
+        return;
+    }
+
+    UE_LOG(LogTemp, Error, TEXT("Failed to update session; retrying %d setting changes"), PendingSettingChanges.Num());
 
-    if (UpdateSessionCompleteDelegateHandle.IsValid())
+    // Always through the ticker: a call that fails synchronously would otherwise retry itself in a loop
+    if (PendingSettingChanges.Num() > 0 && IsInSession())
     {
-        CachedSessionInterface->ClearOnUpdateSessionCompleteDelegate_Handle(UpdateSessionCompleteDelegateHandle);
+        ScheduleSettingsFlush(false);
     }
 }
\ No newline at end of file
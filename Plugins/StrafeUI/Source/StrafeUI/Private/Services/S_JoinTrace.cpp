@@ -0,0 +1,379 @@
+// Plugins/StrafeUI/Source/StrafeUI/Private/Services/S_JoinTrace.cpp
+
+#include "Services/S_JoinTrace.h"
+#include "Containers/Ticker.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "ProfilingDebugging/MiscTrace.h"
+#include "UObject/UObjectGlobals.h"
+
+namespace S_JoinTrace
+{
+    /** Finished traces kept for the overlay and CSV dumps */
+    constexpr int32 MaxRecords = 32;
+
+    /** Finished traces listed on the overlay, newest first */
+    constexpr int32 MaxOverlayRecords = 8;
+
+    /** Seconds between overlay refreshes */
+    constexpr float OverlayRefreshSeconds = 0.5f;
+
+    // Phases recorded from engine delegates once travel has started
+    const TCHAR* const TravelPhase = TEXT("Travel");
+    const TCHAR* const TeardownPhase = TEXT("Teardown");
+    const TCHAR* const MapLoadPhase = TEXT("MapLoad");
+    const TCHAR* const FirstTickPhase = TEXT("FirstTick");
+
+    struct F_ActiveTrace
+    {
+        F_JoinTraceRecord Record;
+
+        /** FPlatformTime::Seconds() when the trace began */
+        double StartSeconds = 0.0;
+
+        /** Index into Record.Phases of the open phase */
+        int32 CurrentPhase = INDEX_NONE;
+    };
+
+    TOptional<F_ActiveTrace> ActiveTrace;
+
+    /** Ring buffer of finished traces; NextRecord is the oldest once the buffer is full */
+    TArray<F_JoinTraceRecord> History;
+    int32 NextRecord = 0;
+
+    FDelegateHandle PreLoadMapHandle;
+    FDelegateHandle PostWorldCleanupHandle;
+    FDelegateHandle PostLoadMapHandle;
+    FDelegateHandle WorldTickStartHandle;
+    FDelegateHandle TravelFailureHandle;
+    FDelegateHandle NetworkFailureHandle;
+
+    FTSTicker::FDelegateHandle OverlayTickerHandle;
+
+    /** On-screen message keys; one per overlay line */
+    constexpr uint64 OverlayMessageKey = 0x53554A54; // "SUJT"
+    int32 NumOverlayLines = 0;
+
+    const TCHAR* GetFlowName(E_JoinTraceFlow Flow)
+    {
+        return Flow == E_JoinTraceFlow::Join ? TEXT("Join") : TEXT("CreateGame");
+    }
+
+    const TCHAR* GetCurrentPhaseName()
+    {
+        if (!ActiveTrace.IsSet() || ActiveTrace->CurrentPhase == INDEX_NONE)
+        {
+            return nullptr;
+        }
+        return ActiveTrace->Record.Phases[ActiveTrace->CurrentPhase].Name;
+    }
+
+    void EndCurrentPhase(double Now)
+    {
+        if (ActiveTrace->CurrentPhase == INDEX_NONE)
+        {
+            return;
+        }
+
+        F_JoinTracePhase& Phase = ActiveTrace->Record.Phases[ActiveTrace->CurrentPhase];
+        Phase.DurationSeconds = (Now - ActiveTrace->StartSeconds) - Phase.StartSeconds;
+        TRACE_END_REGION(Phase.Name);
+        ActiveTrace->CurrentPhase = INDEX_NONE;
+    }
+
+    void RemoveTravelDelegates()
+    {
+        FCoreUObjectDelegates::PreLoadMap.Remove(PreLoadMapHandle);
+        FWorldDelegates::OnPostWorldCleanup.Remove(PostWorldCleanupHandle);
+        FCoreUObjectDelegates::PostLoadMapWithWorld.Remove(PostLoadMapHandle);
+        FWorldDelegates::OnWorldTickStart.Remove(WorldTickStartHandle);
+        if (GEngine)
+        {
+            GEngine->OnTravelFailure().Remove(TravelFailureHandle);
+            GEngine->OnNetworkFailure().Remove(NetworkFailureHandle);
+        }
+
+        PreLoadMapHandle.Reset();
+        PostWorldCleanupHandle.Reset();
+        PostLoadMapHandle.Reset();
+        WorldTickStartHandle.Reset();
+        TravelFailureHandle.Reset();
+        NetworkFailureHandle.Reset();
+    }
+
+    void AddTravelDelegates()
+    {
+        if (PreLoadMapHandle.IsValid())
+        {
+            return;
+        }
+
+        PreLoadMapHandle = FCoreUObjectDelegates::PreLoadMap.AddLambda([](const FString& MapName)
+        {
+            F_JoinTrace::BeginPhase(TeardownPhase);
+        });
+
+        // The old world is cleaned up before the new map is loaded; the garbage collection in between counts as loading
+        PostWorldCleanupHandle = FWorldDelegates::OnPostWorldCleanup.AddLambda([](UWorld* World, bool bSessionEnded, bool bCleanupResources)
+        {
+            if (GetCurrentPhaseName() == TeardownPhase)
+            {
+                F_JoinTrace::BeginPhase(MapLoadPhase);
+            }
+        });
+
+        PostLoadMapHandle = FCoreUObjectDelegates::PostLoadMapWithWorld.AddLambda([](UWorld* World)
+        {
+            F_JoinTrace::BeginPhase(FirstTickPhase);
+        });
+
+        WorldTickStartHandle = FWorldDelegates::OnWorldTickStart.AddLambda([](UWorld* World, ELevelTick TickType, float DeltaSeconds)
+        {
+            if (GetCurrentPhaseName() == FirstTickPhase)
+            {
+                F_JoinTrace::End(true, TEXT("Success"));
+            }
+        });
+
+        if (GEngine)
+        {
+            TravelFailureHandle = GEngine->OnTravelFailure().AddLambda([](UWorld* World, ETravelFailure::Type FailureType, const FString& ErrorString)
+            {
+                F_JoinTrace::End(false, ETravelFailure::ToString(FailureType));
+            });
+
+            NetworkFailureHandle = GEngine->OnNetworkFailure().AddLambda([](UWorld* World, UNetDriver* NetDriver, ENetworkFailure::Type FailureType, const FString& ErrorString)
+            {
+                F_JoinTrace::End(false, ENetworkFailure::ToString(FailureType));
+            });
+        }
+    }
+
+    FString FormatRecord(const F_JoinTraceRecord& Record, double TotalSeconds)
+    {
+        FString Line = FString::Printf(TEXT("%-10s %-24s %-16s %7.0f ms"),
+            GetFlowName(Record.Flow), *Record.Target.Left(24), *Record.Outcome.Left(16), TotalSeconds * 1000.0);
+
+        for (const F_JoinTracePhase& Phase : Record.Phases)
+        {
+            Line += FString::Printf(TEXT(" | %s %.0f"), Phase.Name, Phase.DurationSeconds * 1000.0);
+        }
+        return Line;
+    }
+
+    void ClearOverlay()
+    {
+        if (GEngine)
+        {
+            for (int32 LineIndex = 0; LineIndex < NumOverlayLines; ++LineIndex)
+            {
+                GEngine->RemoveOnScreenDebugMessage(OverlayMessageKey + LineIndex);
+            }
+        }
+        NumOverlayLines = 0;
+    }
+
+    bool TickOverlay(float DeltaTime)
+    {
+        if (!GEngine)
+        {
+            return true;
+        }
+
+        TArray<FString, TInlineAllocator<MaxOverlayRecords + 2>> Lines;
+        Lines.Add(TEXT("Join traces (ms)"));
+
+        if (ActiveTrace.IsSet())
+        {
+            const double Elapsed = FPlatformTime::Seconds() - ActiveTrace->StartSeconds;
+            const TCHAR* PhaseName = GetCurrentPhaseName();
+            Lines.Add(FormatRecord(ActiveTrace->Record, Elapsed) + FString::Printf(TEXT("  <- %s"), PhaseName ? PhaseName : TEXT("...")));
+        }
+
+        TArray<F_JoinTraceRecord> Records;
+        F_JoinTrace::GetHistory(Records);
+        for (int32 Index = Records.Num() - 1; Index >= FMath::Max(0, Records.Num() - MaxOverlayRecords); --Index)
+        {
+            Lines.Add(FormatRecord(Records[Index], Records[Index].TotalSeconds));
+        }
+
+        ClearOverlay();
+        for (int32 LineIndex = 0; LineIndex < Lines.Num(); ++LineIndex)
+        {
+            const FColor Color = LineIndex == 0 ? FColor::White : (ActiveTrace.IsSet() && LineIndex == 1 ? FColor::Yellow : FColor::Cyan);
+            GEngine->AddOnScreenDebugMessage(OverlayMessageKey + LineIndex, OverlayRefreshSeconds * 2.0f, Color, Lines[LineIndex]);
+        }
+        NumOverlayLines = Lines.Num();
+        return true;
+    }
+
+    FString EscapeCsv(const FString& Value)
+    {
+        return FString::Printf(TEXT("\"%s\""), *Value.Replace(TEXT("\""), TEXT("\"\"")));
+    }
+
+    FAutoConsoleCommand OverlayCommand(
+        TEXT("StrafeUI.JoinTrace.Overlay"),
+        TEXT("Toggles an on-screen list of recent join and create-game timings."),
+        FConsoleCommandDelegate::CreateLambda([]()
+        {
+            if (OverlayTickerHandle.IsValid())
+            {
+                FTSTicker::GetCoreTicker().RemoveTicker(OverlayTickerHandle);
+                OverlayTickerHandle.Reset();
+                ClearOverlay();
+            }
+            else
+            {
+                OverlayTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&TickOverlay), OverlayRefreshSeconds);
+                TickOverlay(0.0f);
+            }
+        }));
+
+    FAutoConsoleCommand DumpCsvCommand(
+        TEXT("StrafeUI.JoinTrace.DumpCsv"),
+        TEXT("Writes recent join and create-game timings to a CSV file. Optional argument: file path."),
+        FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+        {
+            F_JoinTrace::DumpToCsv(Args.Num() > 0 ? Args[0] : F_JoinTrace::GetDefaultCsvPath());
+        }));
+}
+
+void F_JoinTrace::Begin(E_JoinTraceFlow Flow, const FString& Target)
+{
+    check(IsInGameThread());
+
+    if (S_JoinTrace::ActiveTrace.IsSet())
+    {
+        End(false, TEXT("Abandoned"));
+    }
+
+    S_JoinTrace::F_ActiveTrace& Trace = S_JoinTrace::ActiveTrace.Emplace();
+    Trace.Record.Flow = Flow;
+    Trace.Record.Target = Target;
+    Trace.Record.StartTime = FDateTime::Now();
+    Trace.StartSeconds = FPlatformTime::Seconds();
+
+    TRACE_BEGIN_REGION(S_JoinTrace::GetFlowName(Flow));
+}
+
+void F_JoinTrace::BeginPhase(const TCHAR* PhaseName)
+{
+    check(IsInGameThread());
+
+    if (!S_JoinTrace::ActiveTrace.IsSet())
+    {
+        return;
+    }
+
+    const double Now = FPlatformTime::Seconds();
+    S_JoinTrace::EndCurrentPhase(Now);
+
+    S_JoinTrace::F_ActiveTrace& Trace = S_JoinTrace::ActiveTrace.GetValue();
+    F_JoinTracePhase& Phase = Trace.Record.Phases.AddDefaulted_GetRef();
+    Phase.Name = PhaseName;
+    Phase.StartSeconds = Now - Trace.StartSeconds;
+    Trace.CurrentPhase = Trace.Record.Phases.Num() - 1;
+
+    TRACE_BEGIN_REGION(PhaseName);
+}
+
+void F_JoinTrace::BeginTravel()
+{
+    if (!S_JoinTrace::ActiveTrace.IsSet())
+    {
+        return;
+    }
+
+    BeginPhase(S_JoinTrace::TravelPhase);
+    S_JoinTrace::AddTravelDelegates();
+}
+
+void F_JoinTrace::End(bool bSucceeded, const FString& Outcome)
+{
+    check(IsInGameThread());
+
+    if (!S_JoinTrace::ActiveTrace.IsSet())
+    {
+        return;
+    }
+
+    const double Now = FPlatformTime::Seconds();
+    S_JoinTrace::EndCurrentPhase(Now);
+    S_JoinTrace::RemoveTravelDelegates();
+
+    F_JoinTraceRecord Record = MoveTemp(S_JoinTrace::ActiveTrace->Record);
+    Record.TotalSeconds = Now - S_JoinTrace::ActiveTrace->StartSeconds;
+    Record.Outcome = Outcome;
+    Record.bSucceeded = bSucceeded;
+    S_JoinTrace::ActiveTrace.Reset();
+
+    TRACE_END_REGION(S_JoinTrace::GetFlowName(Record.Flow));
+    UE_LOG(LogTemp, Log, TEXT("Join trace: %s"), *S_JoinTrace::FormatRecord(Record, Record.TotalSeconds));
+
+    if (S_JoinTrace::History.Num() < S_JoinTrace::MaxRecords)
+    {
+        S_JoinTrace::History.Add(MoveTemp(Record));
+    }
+    else
+    {
+        S_JoinTrace::History[S_JoinTrace::NextRecord] = MoveTemp(Record);
+        S_JoinTrace::NextRecord = (S_JoinTrace::NextRecord + 1) % S_JoinTrace::MaxRecords;
+    }
+}
+
+bool F_JoinTrace::IsActive()
+{
+    return S_JoinTrace::ActiveTrace.IsSet();
+}
+
+void F_JoinTrace::GetHistory(TArray<F_JoinTraceRecord>& OutRecords)
+{
+    OutRecords.Reset(S_JoinTrace::History.Num());
+    for (int32 Offset = 0; Offset < S_JoinTrace::History.Num(); ++Offset)
+    {
+        OutRecords.Add(S_JoinTrace::History[(S_JoinTrace::NextRecord + Offset) % S_JoinTrace::History.Num()]);
+    }
+}
+
+bool F_JoinTrace::DumpToCsv(const FString& FilePath)
+{
+    TArray<F_JoinTraceRecord> Records;
+    GetHistory(Records);
+
+    FString Csv = TEXT("Flow,Target,StartTime,Outcome,Succeeded,TotalMs,Phase,PhaseStartMs,PhaseMs\n");
+    for (const F_JoinTraceRecord& Record : Records)
+    {
+        const FString RecordColumns = FString::Printf(TEXT("%s,%s,%s,%s,%d,%.3f"),
+            S_JoinTrace::GetFlowName(Record.Flow), *S_JoinTrace::EscapeCsv(Record.Target), *Record.StartTime.ToIso8601(),
+            *S_JoinTrace::EscapeCsv(Record.Outcome), Record.bSucceeded ? 1 : 0, Record.TotalSeconds * 1000.0);
+
+        for (const F_JoinTracePhase& Phase : Record.Phases)
+        {
+            Csv += FString::Printf(TEXT("%s,%s,%.3f,%.3f\n"), *RecordColumns, Phase.Name, Phase.StartSeconds * 1000.0, Phase.DurationSeconds * 1000.0);
+        }
+
+        // Attempts that failed before their first phase still get a line
+        if (Record.Phases.Num() == 0)
+        {
+            Csv += RecordColumns + TEXT(",,,\n");
+        }
+    }
+
+    if (!FFileHelper::SaveStringToFile(Csv, *FilePath))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Failed to write join traces: %s"), *FilePath);
+        return false;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("Wrote %d join traces to %s"), Records.Num(), *FilePath);
+    return true;
+}
+
+FString F_JoinTrace::GetDefaultCsvPath()
+{
+    return FPaths::Combine(FPaths::ProfilingDir(), TEXT("JoinTraces.csv"));
+}
\ No newline at end of file
@@ -0,0 +1,199 @@
+// Plugins/StrafeUI/Source/StrafeUI/Private/Services/S_ServerListCache.cpp
+
+#include "Services/S_ServerListCache.h"
+#include "ViewModel/S_UI_VM_ServerBrowser.h"
+#include "HAL/PlatformFileManager.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Async/Async.h"
+#include "Misc/ScopeLock.h"
+
+namespace S_ServerListCache
+{
+    /** "SSLC" */
+    constexpr uint32 Magic = 0x534C5343;
+
+    /** Bump whenever the row layout changes */
+    constexpr uint32 Version = 4;
+
+    /** Smallest serialized row: key, three int32 counts, the flags byte and three empty string lengths */
+    constexpr int64 MinRowSize = sizeof(int64) + 3 * sizeof(int32) + sizeof(uint8) + 3 * sizeof(int32);
+
+    /** Guards PendingSave and bSaveRunning */
+    FCriticalSection SaveLock;
+
+    /** Latest servers waiting to be written; older ones are dropped unwritten */
+    TOptional<TArray<F_ServerInfo>> PendingSave;
+
+    /** True while a worker is writing saves, in which case it also writes PendingSave */
+    bool bSaveRunning = false;
+
+    enum ERowFlags : uint8
+    {
+        RowFlag_Private = 1 << 0,
+        RowFlag_LAN = 1 << 1,
+        RowFlag_FoundOnLAN = 1 << 2
+    };
+
+    void SerializeRow(FArchive& Ar, F_ServerInfo& ServerInfo)
+    {
+        FString ServerName = ServerInfo.ServerName.ToString();
+        FString GameMode = ServerInfo.GameMode.ToString();
+        FString MapName = ServerInfo.CurrentMap.ToString();
+        uint8 RowFlags = (ServerInfo.bIsPrivate ? RowFlag_Private : 0) | (ServerInfo.bIsLAN ? RowFlag_LAN : 0)
+            | (ServerInfo.Source == E_ServerSource::LAN ? RowFlag_FoundOnLAN : 0);
+
+        Ar << ServerInfo.SessionKey;
+        Ar << ServerInfo.PlayerCount;
+        Ar << ServerInfo.MaxPlayers;
+        Ar << ServerInfo.Ping;
+        Ar << RowFlags;
+        Ar << ServerName;
+        Ar << GameMode;
+        Ar << MapName;
+
+        if (Ar.IsLoading())
+        {
+            ServerInfo.ServerName = FText::FromString(ServerName);
+            ServerInfo.GameMode = FText::FromString(GameMode);
+            ServerInfo.CurrentMap = FText::FromString(MapName);
+            ServerInfo.bIsPrivate = (RowFlags & RowFlag_Private) != 0;
+            ServerInfo.bIsLAN = (RowFlags & RowFlag_LAN) != 0;
+            ServerInfo.Source = (RowFlags & RowFlag_FoundOnLAN) != 0 ? E_ServerSource::LAN : E_ServerSource::Online;
+            ServerInfo.bIsStale = true;
+        }
+    }
+
+    bool ReadRows(TArrayView<const uint8> Bytes, TArray<F_ServerInfo>& OutServers)
+    {
+        FMemoryReaderView Reader(Bytes);
+
+        uint32 FileMagic = 0;
+        uint32 FileVersion = 0;
+        int32 NumRows = 0;
+        Reader << FileMagic;
+        Reader << FileVersion;
+        Reader << NumRows;
+
+        // The count comes from disk; a count the remaining bytes cannot hold would make the reservation below huge
+        if (Reader.IsError() || FileMagic != Magic || FileVersion != Version || NumRows < 0 || NumRows > (Reader.TotalSize() - Reader.Tell()) / MinRowSize)
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Ignoring server list cache with unexpected header"));
+            return false;
+        }
+
+        OutServers.Reset(NumRows);
+        for (int32 Index = 0; Index < NumRows && !Reader.IsError(); ++Index)
+        {
+            SerializeRow(Reader, OutServers.AddDefaulted_GetRef());
+        }
+
+        if (Reader.IsError())
+        {
+            UE_LOG(LogTemp, Warning, TEXT("Server list cache is truncated"));
+            OutServers.Reset();
+            return false;
+        }
+
+        return true;
+    }
+}
+
+bool F_ServerListCache::Save(const TArray<F_ServerInfo>& Servers)
+{
+    TArray<uint8> Bytes;
+    FMemoryWriter Writer(Bytes);
+
+    uint32 FileMagic = S_ServerListCache::Magic;
+    uint32 FileVersion = S_ServerListCache::Version;
+    int32 NumRows = Servers.Num();
+    Writer << FileMagic;
+    Writer << FileVersion;
+    Writer << NumRows;
+
+    for (const F_ServerInfo& ServerInfo : Servers)
+    {
+        F_ServerInfo Row = ServerInfo;
+        S_ServerListCache::SerializeRow(Writer, Row);
+    }
+
+    // Write to a temporary file first so a crash mid-write never leaves a corrupt cache behind
+    const FString CachePath = GetCacheFilePath();
+    const FString TempPath = CachePath + TEXT(".tmp");
+    if (!FFileHelper::SaveArrayToFile(Bytes, *TempPath) || !IFileManager::Get().Move(*CachePath, *TempPath))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Failed to write server list cache: %s"), *CachePath);
+        return false;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("Saved %d servers to the server list cache"), NumRows);
+    return true;
+}
+
+void F_ServerListCache::SaveAsync(TArray<F_ServerInfo>&& Servers)
+{
+    {
+        FScopeLock Lock(&S_ServerListCache::SaveLock);
+        S_ServerListCache::PendingSave = MoveTemp(Servers);
+        if (S_ServerListCache::bSaveRunning)
+        {
+            // The running worker writes it once its current save is done
+            return;
+        }
+        S_ServerListCache::bSaveRunning = true;
+    }
+
+    // One worker at a time, so saves never interleave on the temporary file
+    Async(EAsyncExecution::ThreadPool, []()
+    {
+        for (;;)
+        {
+            TArray<F_ServerInfo> ServersToSave;
+            {
+                FScopeLock Lock(&S_ServerListCache::SaveLock);
+                if (!S_ServerListCache::PendingSave.IsSet())
+                {
+                    S_ServerListCache::bSaveRunning = false;
+                    return;
+                }
+                ServersToSave = MoveTemp(S_ServerListCache::PendingSave.GetValue());
+                S_ServerListCache::PendingSave.Reset();
+            }
+
+            Save(ServersToSave);
+        }
+    });
+}
+
+bool F_ServerListCache::Load(TArray<F_ServerInfo>& OutServers)
+{
+    const FString CachePath = GetCacheFilePath();
+
+    // Map the file when possible so loading never copies it
+    IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+    TUniquePtr<IMappedFileHandle> MappedFile(PlatformFile.OpenMapped(*CachePath));
+    if (MappedFile)
+    {
+        TUniquePtr<IMappedFileRegion> MappedRegion(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
+        if (MappedRegion)
+        {
+            return S_ServerListCache::ReadRows(TArrayView<const uint8>(MappedRegion->GetMappedPtr(), (int32)MappedRegion->GetMappedSize()), OutServers);
+        }
+    }
+
+    TArray<uint8> Bytes;
+    if (!FFileHelper::LoadFileToArray(Bytes, *CachePath, FILEREAD_Silent))
+    {
+        return false;
+    }
+
+    return S_ServerListCache::ReadRows(Bytes, OutServers);
+}
+
+FString F_ServerListCache::GetCacheFilePath()
+{
+    return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("ServerBrowser"), TEXT("ServerListCache.bin"));
+}
\ No newline at end of file
@@ -53,6 +53,11 @@ void US_UI_CreateGameWidget::NativeOnInitialized()
         Sld_MaxPlayers->OnValueChanged.AddDynamic(this, &US_UI_CreateGameWidget::OnMaxPlayersChanged);
     }
 
+    if (Cmb_Map)
+    {
+        Cmb_Map->OnSelectionChanged.AddDynamic(this, &US_UI_CreateGameWidget::OnMapSelectionChanged);
+    }
+
     if (Btn_ModeStrafe)
     {
         GameModeButtonGroup->AddWidget(Btn_ModeStrafe);
@@ -119,6 +124,15 @@ void US_UI_CreateGameWidget::OnGameModeButtonSelected(UCommonButtonBase* Selecte
     }
 }
 
+void US_UI_CreateGameWidget::OnMapSelectionChanged(FString SelectedItem, ESelectInfo::Type SelectionType)
+{
+    // Direct selections come from OnViewModelDataChanged mirroring the view model
+    if (SelectionType != ESelectInfo::Direct && ViewModel.IsValid())
+    {
+        ViewModel->OnMapChanged(SelectedItem);
+    }
+}
+
 void US_UI_CreateGameWidget::OnMaxPlayersChanged(float Value)
 {
     if (Txt_MaxPlayersValue)
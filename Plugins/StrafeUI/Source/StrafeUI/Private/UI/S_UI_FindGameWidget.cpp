@@ -3,11 +3,14 @@
 #include "ViewModel/S_UI_VM_ServerBrowser.h"
 #include "CommonButtonBase.h"
 #include "UI/S_UI_CollapsibleBox.h"
+#include "UI/S_UI_StringComboBox.h"
 #include "S_UI_Settings.h"
 #include "Components/ListView.h"
 #include "Components/CheckBox.h"
+#include "Components/TextBlock.h"
 #include "S_UI_Subsystem.h"
 #include "S_UI_Navigator.h"
+#include "TimerManager.h"
 
 US_UI_ViewModelBase* US_UI_FindGameWidget::CreateViewModel()
 {
@@ -22,17 +25,22 @@ void US_UI_FindGameWidget::SetViewModel(US_UI_ViewModelBase* InViewModel)
 
         // Bind to the ViewModel's OnDataChanged delegate to be notified of updates.
         ViewModel->OnDataChanged.AddUniqueDynamic(this, &US_UI_FindGameWidget::OnServerListUpdated);
+        ViewModel->OnServerInfoUpdated.AddUniqueDynamic(this, &US_UI_FindGameWidget::OnServerInfoUpdated);
 
         // Bind the refresh button click now that the ViewModel is valid.
         if (Btn_Refresh)
         {
             // Clear any previous bindings to be safe
             Btn_Refresh->OnClicked().Clear();
-            Btn_Refresh->OnClicked().AddUObject(ViewModel.Get(), &US_UI_VM_ServerBrowser::RequestServerListRefresh);
+            Btn_Refresh->OnClicked().AddUObject(ViewModel.Get(), &US_UI_VM_ServerBrowser::RevalidateServerList);
         }
 
-        // Trigger an initial server list refresh when the screen is opened.
+        // Show the mode the first search will use
+        SyncSearchModeWidgets();
+
+        // Trigger an initial server list refresh when the screen is opened, then keep the list current in place.
         ViewModel->RequestServerListRefresh();
+        ViewModel->SetAutoRefreshEnabled(true);
     }
 }
 
@@ -44,6 +52,15 @@ void US_UI_FindGameWidget::NativeOnInitialized()
     {
         Chk_SearchLAN->OnCheckStateChanged.AddDynamic(this, &US_UI_FindGameWidget::HandleSearchLANChanged);
     }
+    if (Cmb_SearchMode)
+    {
+        const UEnum* SearchModeEnum = StaticEnum<E_ServerSearchMode>();
+        for (const E_ServerSearchMode Mode : { E_ServerSearchMode::Online, E_ServerSearchMode::LAN, E_ServerSearchMode::Combined })
+        {
+            Cmb_SearchMode->AddOption(SearchModeEnum->GetDisplayNameTextByValue((int64)Mode).ToString());
+        }
+        Cmb_SearchMode->OnSelectionChanged.AddDynamic(this, &US_UI_FindGameWidget::HandleSearchModeChanged);
+    }
 
     //if (Btn_Refresh && ViewModel.IsValid())
     //{
@@ -58,6 +75,27 @@ void US_UI_FindGameWidget::NativeOnInitialized()
     {
         Btn_Back->OnClicked().AddUObject(this, &US_UI_FindGameWidget::HandleBackClicked);
     }
+    if (Btn_QuickJoin)
+    {
+        Btn_QuickJoin->OnClicked().AddUObject(this, &US_UI_FindGameWidget::HandleQuickJoinClicked);
+    }
+
+    // Bind the optional sort headers
+    const TPair<UCommonButtonBase*, E_ServerSortColumn> SortHeaders[] =
+    {
+        { Btn_SortName, E_ServerSortColumn::Name },
+        { Btn_SortMap, E_ServerSortColumn::Map },
+        { Btn_SortGameMode, E_ServerSortColumn::GameMode },
+        { Btn_SortPlayers, E_ServerSortColumn::Players },
+        { Btn_SortPing, E_ServerSortColumn::Ping }
+    };
+    for (const TPair<UCommonButtonBase*, E_ServerSortColumn>& SortHeader : SortHeaders)
+    {
+        if (SortHeader.Key)
+        {
+            SortHeader.Key->OnClicked().AddUObject(this, &US_UI_FindGameWidget::HandleSortClicked, SortHeader.Value);
+        }
+    }
 
     if (List_Servers)
     {
@@ -77,59 +115,131 @@ void US_UI_FindGameWidget::NativeOnInitialized()
     }
 }
 
-void US_UI_FindGameWidget::OnServerListUpdated()
+void US_UI_FindGameWidget::NativeConstruct()
 {
-    if (ViewModel.IsValid() && List_Servers)
+    Super::NativeConstruct();
+
+    // Keep the ping of the rows on screen current without re-running the search
+    const float PingRefreshInterval = GetDefault<US_UI_Settings>()->ServerPingRefreshIntervalSeconds;
+    if (PingRefreshInterval > 0.0f)
     {
-        // Store the currently selected item before clearing
-        US_UI_VM_ServerListEntry* PreviouslySelected = List_Servers->GetSelectedItem<US_UI_VM_ServerListEntry>();
-        FString PreviousServerName;
-        if (PreviouslySelected)
+        if (UWorld* World = GetWorld())
         {
-            PreviousServerName = PreviouslySelected->ServerInfo.ServerName.ToString();
+            World->GetTimerManager().SetTimer(PingRefreshTimerHandle, this, &US_UI_FindGameWidget::RefreshVisiblePings, PingRefreshInterval, true);
         }
+    }
 
-        List_Servers->ClearListItems();
+    if (ViewModel.IsValid())
+    {
+        ViewModel->SetAutoRefreshEnabled(true);
+    }
+}
 
-        // Populate the list view with data from the ViewModel.
+void US_UI_FindGameWidget::NativeDestruct()
+{
+    if (UWorld* World = GetWorld())
+    {
+        World->GetTimerManager().ClearTimer(PingRefreshTimerHandle);
+    }
+
+    // Nobody is looking at the list while the screen is gone
+    if (ViewModel.IsValid())
+    {
+        ViewModel->SetAutoRefreshEnabled(false);
+    }
+
+    Super::NativeDestruct();
+}
+
+void US_UI_FindGameWidget::OnServerListUpdated()
+{
+    if (ViewModel.IsValid() && List_Servers)
+    {
+        // Collect the ViewModel's own entries, looked up by session key.
+        TArray<UObject*> Items;
+        Items.Reserve(ViewModel->ServerList.Num());
         for (const F_ServerInfo& ServerInfo : ViewModel->ServerList)
         {
-            // Create a UObject wrapper for our list entry data
-            US_UI_VM_ServerListEntry* Entry = NewObject<US_UI_VM_ServerListEntry>(this);
-            Entry->ServerInfo = ServerInfo;
-
-            // Find the corresponding full search result from the ViewModel's internal list
-            // This is needed for the join functionality
-            for (const auto& FoundServer : ViewModel->AllFoundServers)
+            if (US_UI_VM_ServerListEntry* Entry = ViewModel->FindServerEntry(ServerInfo.SessionKey))
             {
-                if (FoundServer &&
-                    FoundServer->ServerInfo.ServerName.EqualTo(ServerInfo.ServerName) &&
-                    FoundServer->ServerInfo.Ping == ServerInfo.Ping)
-                {
-                    Entry->SessionSearchResult = FoundServer->SessionSearchResult;
-                    break;
-                }
+                Items.Add(Entry);
             }
+        }
 
-            // Add the data object to the list view. The list view will create a widget for it.
-            List_Servers->AddItem(Entry);
-
-            // Try to restore selection if this was the previously selected server
-            if (!PreviousServerName.IsEmpty() && Entry->ServerInfo.ServerName.ToString() == PreviousServerName)
+        // Apply only the differences so surviving rows keep their widgets, selection and scroll position.
+        ServerListReconciler.Reconcile(*List_Servers, Items,
+            [](const UObject* Item)
             {
-                List_Servers->SetSelectedItem(Entry);
-            }
+                return (uint64)CastChecked<US_UI_VM_ServerListEntry>(Item)->ServerInfo.SessionKey;
+            },
+            [](const UObject* Item)
+            {
+                return CastChecked<US_UI_VM_ServerListEntry>(Item)->GetDisplayHash();
+            });
+
+        // Label the filter options with how many servers they match; throttled while results stream in
+        if (ServerFilterWidget)
+        {
+            ServerFilterWidget->SetFacetCounts(ViewModel->GetFacetCounts(), ViewModel->GetGameModeNames(), ViewModel->GetMapNames(), ViewModel->bIsIngestingResults);
         }
 
         // Update button states
         UpdateButtonStates();
+        UpdateServerDetails();
+        UpdateStatusText();
+    }
+}
+
+void US_UI_FindGameWidget::OnServerInfoUpdated(int64 SessionKey)
+{
+    if (!ViewModel.IsValid() || !List_Servers)
+    {
+        return;
+    }
+
+    // Rows that are not on screen pick up the new data when they are generated
+    if (US_UI_VM_ServerListEntry* Entry = ViewModel->FindServerEntry(SessionKey))
+    {
+        if (IRefreshableListEntry* EntryWidget = Cast<IRefreshableListEntry>(List_Servers->GetEntryWidgetFromItem(Entry)))
+        {
+            EntryWidget->RefreshListItem(Entry);
+        }
+    }
+}
+
+void US_UI_FindGameWidget::RefreshVisiblePings()
+{
+    if (!ViewModel.IsValid() || !List_Servers || ViewModel->bIsIngestingResults)
+    {
+        return;
+    }
+
+    TArray<int64> SessionKeys;
+
+    // The selected server first, so it is measured even when scrolled out of view
+    if (const US_UI_VM_ServerListEntry* SelectedItem = List_Servers->GetSelectedItem<US_UI_VM_ServerListEntry>())
+    {
+        SessionKeys.Add(SelectedItem->ServerInfo.SessionKey);
+    }
+
+    for (const UUserWidget* EntryWidget : List_Servers->GetDisplayedEntryWidgets())
+    {
+        if (const US_UI_VM_ServerListEntry* Entry = Cast<US_UI_VM_ServerListEntry>(List_Servers->ItemFromEntryWidget(*EntryWidget)))
+        {
+            SessionKeys.AddUnique(Entry->ServerInfo.SessionKey);
+        }
+    }
+
+    if (SessionKeys.Num() > 0)
+    {
+        ViewModel->RefreshServerPings(SessionKeys);
     }
 }
 
 void US_UI_FindGameWidget::OnServerSelected(UObject* Item)
 {
-    // The only thing we need to do when selection changes is update the button states.
     UpdateButtonStates();
+    UpdateServerDetails();
 }
 
 
@@ -169,13 +279,14 @@ void US_UI_FindGameWidget::HandleJoinClicked()
             Payload.Message = FText::FromString(TEXT("This server appears to be full. Do you still want to try joining?"));
             Payload.ModalType = E_UIModalType::YesNo;
 
-            // Capture the selected item in the lambda
+            // Capture the session key rather than the entry, which may be gone by the time the modal closes
+            const int64 SessionKey = SelectedItem->ServerInfo.SessionKey;
             UISubsystem->RequestModal(Payload, FOnModalDismissedSignature::CreateLambda(
-                [this, SelectedItem](bool bConfirmed)
+                [this, SessionKey](bool bConfirmed)
                 {
                     if (bConfirmed && ViewModel.IsValid())
                     {
-                        ViewModel->JoinSession(SelectedItem->SessionSearchResult);
+                        ViewModel->JoinServer(SessionKey);
                     }
                 }));
         }
@@ -183,7 +294,7 @@ void US_UI_FindGameWidget::HandleJoinClicked()
     else
     {
         // Join directly if server has space
-        ViewModel->JoinSession(SelectedItem->SessionSearchResult);
+        ViewModel->JoinServer(SelectedItem->ServerInfo.SessionKey);
     }
 }
 
@@ -195,6 +306,26 @@ void US_UI_FindGameWidget::HandleBackClicked()
     }
 }
 
+void US_UI_FindGameWidget::HandleQuickJoinClicked()
+{
+    if (ViewModel.IsValid())
+    {
+        // The view model shows its own modal when nothing can be joined
+        ViewModel->QuickJoin();
+    }
+}
+
+void US_UI_FindGameWidget::HandleSortClicked(E_ServerSortColumn Column)
+{
+    if (!ViewModel.IsValid())
+    {
+        return;
+    }
+
+    const bool bDescending = ViewModel->SortColumn == Column ? !ViewModel->bSortDescending : false;
+    ViewModel->SetSort(Column, bDescending);
+}
+
 void US_UI_FindGameWidget::UpdateButtonStates()
 {
     if (Btn_Join && List_Servers)
@@ -205,6 +336,66 @@ void US_UI_FindGameWidget::UpdateButtonStates()
     }
 }
 
+void US_UI_FindGameWidget::UpdateServerDetails()
+{
+    if (!Txt_ServerDescription && !Txt_ServerRules && !Txt_ServerPlayers)
+    {
+        return;
+    }
+
+    // Only the selected server is ever decoded; the view model keeps the record for later selections
+    F_ServerDetails Details;
+    const US_UI_VM_ServerListEntry* SelectedItem = List_Servers ? List_Servers->GetSelectedItem<US_UI_VM_ServerListEntry>() : nullptr;
+    const bool bHasDetails = SelectedItem && ViewModel.IsValid() && ViewModel->GetServerDetails(SelectedItem->ServerInfo.SessionKey, Details);
+
+    if (Txt_ServerDescription)
+    {
+        Txt_ServerDescription->SetText(bHasDetails ? Details.Description : FText::GetEmpty());
+    }
+
+    if (Txt_ServerRules)
+    {
+        Txt_ServerRules->SetText(bHasDetails
+            ? FText::Format(NSLOCTEXT("ServerBrowser", "ServerRules", "Time limit: {0} min   Score limit: {1}   Respawn: {2}s   Friendly fire: {3}   Spectators: {4}"),
+                FText::AsNumber(Details.TimeLimit),
+                FText::AsNumber(Details.ScoreLimit),
+                FText::AsNumber(Details.RespawnTime),
+                Details.bFriendlyFire ? NSLOCTEXT("ServerBrowser", "On", "On") : NSLOCTEXT("ServerBrowser", "Off", "Off"),
+                Details.bAllowSpectators ? NSLOCTEXT("ServerBrowser", "On", "On") : NSLOCTEXT("ServerBrowser", "Off", "Off"))
+            : FText::GetEmpty());
+    }
+
+    if (Txt_ServerPlayers)
+    {
+        Txt_ServerPlayers->SetText(bHasDetails ? FText::FromString(FString::Join(Details.PlayerNames, TEXT("\n"))) : FText::GetEmpty());
+    }
+}
+
+void US_UI_FindGameWidget::UpdateStatusText()
+{
+    if (!Txt_SearchStatus || !ViewModel.IsValid())
+    {
+        return;
+    }
+
+    if (ViewModel->bIsIngestingResults)
+    {
+        Txt_SearchStatus->SetText(FText::Format(NSLOCTEXT("ServerBrowser", "IngestingStatus", "Loading servers... {0}/{1}"),
+            FText::AsNumber(ViewModel->IngestedResultCount),
+            FText::AsNumber(ViewModel->TotalResultCount)));
+    }
+    else if (ViewModel->StaleServerCount > 0)
+    {
+        Txt_SearchStatus->SetText(FText::Format(NSLOCTEXT("ServerBrowser", "CachedStatus", "{0} cached servers, refreshing..."),
+            FText::AsNumber(ViewModel->ServerList.Num())));
+    }
+    else
+    {
+        Txt_SearchStatus->SetText(FText::Format(NSLOCTEXT("ServerBrowser", "ServerCountStatus", "{0} servers"),
+            FText::AsNumber(ViewModel->ServerList.Num())));
+    }
+}
+
 void US_UI_FindGameWidget::OnFiltersChanged()
 {
     if (!ViewModel.IsValid() || !ServerFilterWidget)
@@ -215,6 +406,7 @@ void US_UI_FindGameWidget::OnFiltersChanged()
     // Update the view model's filter properties
     ViewModel->FilterServerName = ServerFilterWidget->GetServerNameFilter();
     ViewModel->FilterGameMode = ServerFilterWidget->GetGameModeFilter();
+    ViewModel->FilterMapName = ServerFilterWidget->GetMapNameFilter();
     ViewModel->bFilterHideFullServers = ServerFilterWidget->GetHideFullServers();
     ViewModel->bFilterHideEmptyServers = ServerFilterWidget->GetHideEmptyServers();
     ViewModel->bFilterHidePrivateServers = ServerFilterWidget->GetHidePrivateServers();
@@ -228,6 +420,41 @@ void US_UI_FindGameWidget::HandleSearchLANChanged(bool bIsChecked)
 {
     if (ViewModel.IsValid())
     {
-        ViewModel->bSearchLAN = bIsChecked;
+        // LAN results are searched alongside online ones rather than instead of them
+        ViewModel->SearchMode = bIsChecked ? E_ServerSearchMode::Combined : E_ServerSearchMode::Online;
+        SyncSearchModeWidgets();
+    }
+}
+
+void US_UI_FindGameWidget::HandleSearchModeChanged(FString SelectedItem, ESelectInfo::Type SelectionType)
+{
+    if (SelectionType == ESelectInfo::Direct || !ViewModel.IsValid() || !Cmb_SearchMode)
+    {
+        return;
+    }
+
+    const int32 SelectedIndex = Cmb_SearchMode->GetSelectedIndex();
+    if (SelectedIndex != INDEX_NONE)
+    {
+        ViewModel->SearchMode = (E_ServerSearchMode)SelectedIndex;
+        SyncSearchModeWidgets();
+    }
+}
+
+void US_UI_FindGameWidget::SyncSearchModeWidgets()
+{
+    if (!ViewModel.IsValid())
+    {
+        return;
+    }
+
+    // SetIsChecked does not notify, and the selector reports a Direct change, so this never feeds back into the handlers
+    if (Chk_SearchLAN)
+    {
+        Chk_SearchLAN->SetIsChecked(ViewModel->SearchMode != E_ServerSearchMode::Online);
+    }
+    if (Cmb_SearchMode)
+    {
+        Cmb_SearchMode->SetSelectedIndex((int32)ViewModel->SearchMode);
     }
 }
\ No newline at end of file
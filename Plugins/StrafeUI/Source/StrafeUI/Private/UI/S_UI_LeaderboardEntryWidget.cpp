@@ -84,6 +84,11 @@ void US_UI_LeaderboardEntryWidget::NativeOnListItemObjectSet(UObject* ListItemOb
     }
 }
 
+void US_UI_LeaderboardEntryWidget::RefreshListItem(UObject* ListItemObject)
+{
+    NativeOnListItemObjectSet(ListItemObject);
+}
+
 void US_UI_LeaderboardEntryWidget::OnPlayReplayClicked()
 {
     if (CachedEntryData.IsValid() && ParentViewModel.IsValid())
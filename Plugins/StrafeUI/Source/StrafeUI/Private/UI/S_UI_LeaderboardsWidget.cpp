@@ -88,11 +88,17 @@ void US_UI_LeaderboardsWidget::OnViewModelDataChanged()
     // Update leaderboard list
     if (ListView_Leaderboard)
     {
-        ListView_Leaderboard->ClearListItems();
-        for (UObject* Entry : ViewModel->LeaderboardEntries)
-        {
-            ListView_Leaderboard->AddItem(Entry);
-        }
+        LeaderboardListReconciler.Reconcile(*ListView_Leaderboard, ViewModel->LeaderboardEntries,
+            [](const UObject* Item)
+            {
+                const US_UI_VM_LeaderboardEntry* Entry = CastChecked<US_UI_VM_LeaderboardEntry>(Item);
+                return (uint64)HashCombine(GetTypeHash(Entry->PlayerName), GetTypeHash(Entry->MapName));
+            },
+            [](const UObject* Item)
+            {
+                const US_UI_VM_LeaderboardEntry* Entry = CastChecked<US_UI_VM_LeaderboardEntry>(Item);
+                return HashCombine(GetTypeHash(Entry->Rank), GetTypeHash(Entry->Time));
+            });
     }
 }
 
@@ -0,0 +1,167 @@
+// Plugins/StrafeUI/Source/StrafeUI/Private/UI/S_UI_ListReconciler.cpp
+
+#include "UI/S_UI_ListReconciler.h"
+#include "Components/ListView.h"
+#include "Blueprint/UserWidget.h"
+
+namespace S_UI_ListReconciler
+{
+    /** Above this many removals a single SetListItems is cheaper than repeated RemoveItem calls */
+    constexpr int32 MaxIndividualRemovals = 16;
+}
+
+F_UIListReconciler::FResult F_UIListReconciler::Reconcile(UListView& ListView, const TArray<UObject*>& NewItems, FGetKey GetKey, FGetContentHash GetContentHash)
+{
+    FResult Result;
+
+    const TArray<UObject*>& OldItems = ListView.GetListItems();
+
+    TMap<uint64, int32> OldIndexByKey;
+    OldIndexByKey.Reserve(OldItems.Num());
+    for (int32 Index = 0; Index < OldItems.Num(); ++Index)
+    {
+        OldIndexByKey.Add(GetKey(OldItems[Index]), Index);
+    }
+
+    TMap<uint64, uint32> NewHashByKey;
+    NewHashByKey.Reserve(NewItems.Num());
+
+    TArray<UObject*> ItemsToRebind;
+
+    // Set whenever the diff cannot be expressed as tail appends plus removals
+    bool bNeedsFullSet = OldIndexByKey.Num() != OldItems.Num();
+    bool bSeenInsert = false;
+    int32 LastOldIndex = INDEX_NONE;
+    int32 SurvivingCount = 0;
+
+    for (UObject* Item : NewItems)
+    {
+        const uint64 Key = GetKey(Item);
+        const uint32 Hash = GetContentHash(Item);
+
+        if (NewHashByKey.Contains(Key))
+        {
+            // Duplicate keys cannot be diffed reliably
+            bNeedsFullSet = true;
+            continue;
+        }
+        NewHashByKey.Add(Key, Hash);
+
+        const int32* OldIndex = OldIndexByKey.Find(Key);
+        if (!OldIndex)
+        {
+            ++Result.Inserted;
+            bSeenInsert = true;
+            continue;
+        }
+
+        ++SurvivingCount;
+
+        // A surviving item after an insert means the insert is not at the tail
+        if (bSeenInsert)
+        {
+            bNeedsFullSet = true;
+        }
+
+        if (*OldIndex < LastOldIndex)
+        {
+            ++Result.Moved;
+            bNeedsFullSet = true;
+        }
+        else
+        {
+            LastOldIndex = *OldIndex;
+        }
+
+        if (OldItems[*OldIndex] != Item)
+        {
+            // Same key but a different object; the list view has to swap the item
+            ++Result.Updated;
+            bNeedsFullSet = true;
+        }
+        else
+        {
+            const uint32* OldHash = ContentHashByKey.Find(Key);
+            if (!OldHash || *OldHash != Hash)
+            {
+                ++Result.Updated;
+                ItemsToRebind.Add(Item);
+            }
+        }
+    }
+
+    Result.Removed = OldItems.Num() - SurvivingCount;
+
+    if (Result.Removed > S_UI_ListReconciler::MaxIndividualRemovals)
+    {
+        bNeedsFullSet = true;
+    }
+
+    if (bNeedsFullSet)
+    {
+        // SetListItems clears the selection, so it is carried over by key; this also follows an item replaced by a new object
+        TArray<UObject*> SelectedItems;
+        ListView.GetSelectedItems(SelectedItems);
+        TSet<uint64> SelectedKeys;
+        for (const UObject* SelectedItem : SelectedItems)
+        {
+            SelectedKeys.Add(GetKey(SelectedItem));
+        }
+
+        ListView.SetListItems(NewItems);
+
+        if (SelectedKeys.Num() > 0)
+        {
+            for (UObject* Item : NewItems)
+            {
+                if (SelectedKeys.Contains(GetKey(Item)))
+                {
+                    ListView.SetItemSelection(Item, true, ESelectInfo::Direct);
+                }
+            }
+        }
+    }
+    else if (Result.Inserted > 0 || Result.Removed > 0)
+    {
+        if (Result.Removed > 0)
+        {
+            TArray<UObject*> ItemsToRemove;
+            ItemsToRemove.Reserve(Result.Removed);
+            for (UObject* OldItem : OldItems)
+            {
+                if (!NewHashByKey.Contains(GetKey(OldItem)))
+                {
+                    ItemsToRemove.Add(OldItem);
+                }
+            }
+
+            for (UObject* OldItem : ItemsToRemove)
+            {
+                ListView.RemoveItem(OldItem);
+            }
+        }
+
+        // Inserts are all at the tail, in order
+        for (int32 Index = NewItems.Num() - Result.Inserted; Index < NewItems.Num(); ++Index)
+        {
+            ListView.AddItem(NewItems[Index]);
+        }
+    }
+
+    // Rebind realised rows whose content changed; rows off screen pick up the new data when they are generated
+    for (UObject* Item : ItemsToRebind)
+    {
+        if (IRefreshableListEntry* Entry = Cast<IRefreshableListEntry>(ListView.GetEntryWidgetFromItem(Item)))
+        {
+            Entry->RefreshListItem(Item);
+        }
+    }
+
+    ContentHashByKey = MoveTemp(NewHashByKey);
+    return Result;
+}
+
+void F_UIListReconciler::Reset()
+{
+    ContentHashByKey.Reset();
+}
@@ -53,6 +53,11 @@ void US_UI_ReplayListEntryWidget::NativeOnListItemObjectSet(UObject* ListItemObj
     }
 }
 
+void US_UI_ReplayListEntryWidget::RefreshListItem(UObject* ListItemObject)
+{
+    NativeOnListItemObjectSet(ListItemObject);
+}
+
 FLinearColor US_UI_ReplayListEntryWidget::GetAgeColor(const FDateTime& Timestamp) const
 {
     FDateTime Now = FDateTime::Now();
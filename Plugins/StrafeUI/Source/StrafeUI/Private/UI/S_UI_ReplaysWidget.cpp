@@ -78,11 +78,16 @@ void US_UI_ReplaysWidget::OnViewModelDataChanged()
     // Update replay list
     if (ListView_Replays)
     {
-        ListView_Replays->ClearListItems();
-        for (UObject* Entry : ViewModel->ReplayEntries)
-        {
-            ListView_Replays->AddItem(Entry);
-        }
+        ReplayListReconciler.Reconcile(*ListView_Replays, ViewModel->ReplayEntries,
+            [](const UObject* Item)
+            {
+                return (uint64)GetTypeHash(CastChecked<US_UI_VM_ReplayEntry>(Item)->FileName);
+            },
+            [](const UObject* Item)
+            {
+                const US_UI_VM_ReplayEntry* Entry = CastChecked<US_UI_VM_ReplayEntry>(Item);
+                return HashCombine(GetTypeHash(Entry->Timestamp), GetTypeHash(Entry->FileSizeKB));
+            });
 
         // Restore selection if needed
         if (ViewModel->SelectedReplay)
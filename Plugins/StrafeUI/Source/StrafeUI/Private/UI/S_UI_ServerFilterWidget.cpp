@@ -6,6 +6,22 @@
 #include "Components/CheckBox.h"
 #include "Components/Slider.h"
 #include "Components/TextBlock.h"
+#include "Algo/Sort.h"
+
+namespace S_ServerFilterWidget
+{
+    /** Game modes always offered, in this order; in a real implementation these would come from game settings */
+    const FString DefaultGameModes[] =
+    {
+        TEXT("Deathmatch"),
+        TEXT("Team Deathmatch"),
+        TEXT("Capture the Flag"),
+        TEXT("Domination")
+    };
+
+    /** Minimum time between facet updates while results stream in; each one regenerates the option rows */
+    constexpr double FacetRefreshIntervalSeconds = 0.5;
+}
 
 void US_UI_ServerFilterWidget::NativeOnInitialized()
 {
@@ -17,21 +33,24 @@ void US_UI_ServerFilterWidget::NativeOnInitialized()
         Txt_ServerName->OnTextChanged.AddDynamic(this, &US_UI_ServerFilterWidget::OnServerNameChanged);
     }
 
-    // Setup game mode combo box
+    // Setup game mode and map combo boxes; counts are added once servers come in
     if (Cmb_GameMode)
     {
-        // Add default "All" option
         Cmb_GameMode->AddOption(TEXT("All"));
-
-        // Add common game modes - in a real implementation, these would come from game settings
-        Cmb_GameMode->AddOption(TEXT("Deathmatch"));
-        Cmb_GameMode->AddOption(TEXT("Team Deathmatch"));
-        Cmb_GameMode->AddOption(TEXT("Capture the Flag"));
-        Cmb_GameMode->AddOption(TEXT("Domination"));
+        for (const FString& GameMode : S_ServerFilterWidget::DefaultGameModes)
+        {
+            Cmb_GameMode->AddOption(GameMode);
+        }
 
         Cmb_GameMode->SetSelectedOption(TEXT("All"));
         Cmb_GameMode->OnSelectionChanged.AddDynamic(this, &US_UI_ServerFilterWidget::OnGameModeSelectionChanged);
     }
+    if (Cmb_MapName)
+    {
+        Cmb_MapName->AddOption(TEXT("All"));
+        Cmb_MapName->SetSelectedOption(TEXT("All"));
+        Cmb_MapName->OnSelectionChanged.AddDynamic(this, &US_UI_ServerFilterWidget::OnMapNameSelectionChanged);
+    }
 
     // Bind checkbox events
     if (Chk_HideFullServers)
@@ -70,12 +89,28 @@ FString US_UI_ServerFilterWidget::GetServerNameFilter() const
 
 FString US_UI_ServerFilterWidget::GetGameModeFilter() const
 {
-    if (Cmb_GameMode)
+    return GetSelectedOptionValue(Cmb_GameMode, GameModeOptionValues);
+}
+
+FString US_UI_ServerFilterWidget::GetMapNameFilter() const
+{
+    return GetSelectedOptionValue(Cmb_MapName, MapOptionValues);
+}
+
+FString US_UI_ServerFilterWidget::GetSelectedOptionValue(const US_UI_StringComboBox* ComboBox, const TMap<FString, FString>& OptionValues)
+{
+    if (!ComboBox)
     {
-        FString SelectedMode = Cmb_GameMode->GetSelectedOption();
-        return (SelectedMode == TEXT("All")) ? FString() : SelectedMode;
+        return FString();
     }
-    return FString();
+
+    // Options are plain values until the first facet counts arrive
+    const FString SelectedOption = ComboBox->GetSelectedOption();
+    if (const FString* Value = OptionValues.Find(SelectedOption))
+    {
+        return *Value;
+    }
+    return (SelectedOption == TEXT("All")) ? FString() : SelectedOption;
 }
 
 bool US_UI_ServerFilterWidget::GetHideFullServers() const
@@ -111,9 +146,15 @@ void US_UI_ServerFilterWidget::ResetFilters()
         Txt_ServerName->SetText(FText::GetEmpty());
     }
 
+    // "All" is always the first option
     if (Cmb_GameMode)
     {
-        Cmb_GameMode->SetSelectedOption(TEXT("All"));
+        Cmb_GameMode->SetSelectedIndex(0);
+    }
+
+    if (Cmb_MapName)
+    {
+        Cmb_MapName->SetSelectedIndex(0);
     }
 
     if (Chk_HideFullServers)
@@ -157,6 +198,14 @@ void US_UI_ServerFilterWidget::OnGameModeSelectionChanged(FString SelectedItem,
     }
 }
 
+void US_UI_ServerFilterWidget::OnMapNameSelectionChanged(FString SelectedItem, ESelectInfo::Type SelectionType)
+{
+    if (SelectionType != ESelectInfo::Direct)
+    {
+        BroadcastFilterChange();
+    }
+}
+
 void US_UI_ServerFilterWidget::OnHideFullServersChanged(bool bIsChecked)
 {
     BroadcastFilterChange();
@@ -193,4 +242,130 @@ void US_UI_ServerFilterWidget::OnMaxPingChanged(float Value)
 void US_UI_ServerFilterWidget::BroadcastFilterChange()
 {
     OnFiltersChanged.Broadcast();
+}
+
+void US_UI_ServerFilterWidget::SetFacetCounts(const F_ServerFacetCounts& Facets, const F_ServerNameTable& GameModeNames, const F_ServerNameTable& MapNames, bool bThrottle)
+{
+    if (Facets.Revision == AppliedFacetRevision)
+    {
+        return;
+    }
+
+    // Every ingested row bumps the revision; the caller applies the final counts unthrottled once ingestion ends
+    const double Now = FPlatformTime::Seconds();
+    if (bThrottle && Now - LastFacetApplySeconds < S_ServerFilterWidget::FacetRefreshIntervalSeconds)
+    {
+        return;
+    }
+    AppliedFacetRevision = Facets.Revision;
+    LastFacetApplySeconds = Now;
+
+    if (Cmb_GameMode)
+    {
+        RebuildFacetOptions(Cmb_GameMode, Facets.GameModeCounts, GameModeNames, S_ServerFilterWidget::DefaultGameModes, Facets.NumServers, GameModeOptionValues);
+    }
+    if (Cmb_MapName)
+    {
+        RebuildFacetOptions(Cmb_MapName, Facets.MapCounts, MapNames, TArrayView<const FString>(), Facets.NumServers, MapOptionValues);
+    }
+
+    if (Txt_FullServerCount)
+    {
+        Txt_FullServerCount->SetText(FText::AsNumber(Facets.NumFull));
+    }
+    if (Txt_EmptyServerCount)
+    {
+        Txt_EmptyServerCount->SetText(FText::AsNumber(Facets.NumEmpty));
+    }
+    if (Txt_PrivateServerCount)
+    {
+        Txt_PrivateServerCount->SetText(FText::AsNumber(Facets.NumPrivate));
+    }
+}
+
+void US_UI_ServerFilterWidget::RebuildFacetOptions(US_UI_StringComboBox* ComboBox, const TArray<int32>& Counts, const F_ServerNameTable& Names,
+    TArrayView<const FString> DefaultValues, int32 NumServers, TMap<FString, FString>& InOutOptionValues)
+{
+    const FString SelectedValue = GetSelectedOptionValue(ComboBox, InOutOptionValues);
+
+    // Default values keep their order; everything else follows, most common first
+    TArray<TPair<FString, int32>> Values;
+    TArray<int32, TInlineAllocator<8>> DefaultIds;
+    for (const FString& DefaultValue : DefaultValues)
+    {
+        const int32 Id = Names.Find(DefaultValue);
+        DefaultIds.Add(Id);
+        Values.Emplace(DefaultValue, Counts.IsValidIndex(Id) ? Counts[Id] : 0);
+    }
+
+    const int32 NumDefaultValues = Values.Num();
+    for (int32 Id = 0; Id < Counts.Num(); ++Id)
+    {
+        if (Counts[Id] > 0 && !DefaultIds.Contains(Id))
+        {
+            Values.Emplace(Names.GetDisplayName(Id).ToString(), Counts[Id]);
+        }
+    }
+    Algo::Sort(MakeArrayView(Values).RightChop(NumDefaultValues), [](const TPair<FString, int32>& A, const TPair<FString, int32>& B)
+    {
+        return A.Value != B.Value ? A.Value > B.Value : A.Key < B.Key;
+    });
+
+    // A selection no server matches anymore stays listed so the filter does not silently change
+    if (!SelectedValue.IsEmpty() && !Values.ContainsByPredicate([&SelectedValue](const TPair<FString, int32>& Value) { return Value.Key.Equals(SelectedValue, ESearchCase::IgnoreCase); }))
+    {
+        Values.Emplace(SelectedValue, 0);
+    }
+
+    // Same values in the same order: only the counts in the labels changed
+    bool bSameValues = ComboBox->GetOptionCount() == Values.Num() + 1;
+    for (int32 Index = 0; bSameValues && Index < Values.Num(); ++Index)
+    {
+        const FString* OptionValue = InOutOptionValues.Find(ComboBox->GetOptionAtIndex(Index + 1));
+        bSameValues = OptionValue && *OptionValue == Values[Index].Key;
+    }
+
+    if (!bSameValues)
+    {
+        ComboBox->ClearOptions();
+    }
+    InOutOptionValues.Reset();
+
+    const FString AllLabel = FString::Printf(TEXT("All (%d)"), NumServers);
+    InOutOptionValues.Add(AllLabel, FString());
+    if (bSameValues)
+    {
+        ComboBox->SetOptionAtIndex(0, AllLabel);
+    }
+    else
+    {
+        ComboBox->AddOption(AllLabel);
+    }
+
+    FString SelectedLabel = AllLabel;
+    for (int32 Index = 0; Index < Values.Num(); ++Index)
+    {
+        const TPair<FString, int32>& Value = Values[Index];
+        const FString Label = FString::Printf(TEXT("%s (%d)"), *Value.Key, Value.Value);
+        InOutOptionValues.Add(Label, Value.Key);
+        if (bSameValues)
+        {
+            ComboBox->SetOptionAtIndex(Index + 1, Label);
+        }
+        else
+        {
+            ComboBox->AddOption(Label);
+        }
+
+        if (!SelectedValue.IsEmpty() && Value.Key.Equals(SelectedValue, ESearchCase::IgnoreCase))
+        {
+            SelectedLabel = Label;
+        }
+    }
+
+    // Relabelling keeps the selection; direct selections are not reported as filter changes
+    if (!bSameValues)
+    {
+        ComboBox->SetSelectedOption(SelectedLabel);
+    }
 }
\ No newline at end of file
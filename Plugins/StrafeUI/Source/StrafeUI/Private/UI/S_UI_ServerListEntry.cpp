@@ -28,6 +28,9 @@ void US_UI_ServerListEntry::NativeOnListItemObjectSet(UObject* ListItemObject)
         CachedServerData = ServerEntry;
         const F_ServerInfo& ServerInfo = ServerEntry->ServerInfo;
 
+        // Everything formatted was built by the view model when the server info changed; rows only copy it
+        const F_ServerRowDisplay& Display = ServerEntry->Display;
+
         // Update server name
         if (Txt_ServerName)
         {
@@ -43,46 +46,34 @@ void US_UI_ServerListEntry::NativeOnListItemObjectSet(UObject* ListItemObject)
         // Update map name
         if (Txt_MapName)
         {
-            Txt_MapName->SetText(FText::FromString(ServerInfo.CurrentMap));
+            Txt_MapName->SetText(ServerInfo.CurrentMap);
         }
 
-        // Update player count
+        // Update player count, colored by server capacity
         if (Txt_PlayerCount)
         {
-            Txt_PlayerCount->SetText(GetPlayerCountText(ServerInfo.PlayerCount, ServerInfo.MaxPlayers));
-
-            // Set color based on server capacity
-            FLinearColor CountColor = GetServerStatusColor(ServerInfo.PlayerCount, ServerInfo.MaxPlayers);
-            Txt_PlayerCount->SetColorAndOpacity(FSlateColor(CountColor));
+            Txt_PlayerCount->SetText(Display.PlayerCount);
+            Txt_PlayerCount->SetColorAndOpacity(FSlateColor(Display.CapacityColor));
         }
 
         // Update server capacity bar
         if (Bar_ServerCapacity)
         {
-            float FillPercent = ServerInfo.MaxPlayers > 0 ?
-                (float)ServerInfo.PlayerCount / (float)ServerInfo.MaxPlayers : 0.0f;
-            Bar_ServerCapacity->SetPercent(FillPercent);
-
-            // Set bar color based on capacity
-            FLinearColor BarColor = GetServerStatusColor(ServerInfo.PlayerCount, ServerInfo.MaxPlayers);
-            Bar_ServerCapacity->SetFillColorAndOpacity(BarColor);
+            Bar_ServerCapacity->SetPercent(Display.FillPercent);
+            Bar_ServerCapacity->SetFillColorAndOpacity(Display.CapacityColor);
         }
 
-        // Update ping
+        // Update ping, colored by ping quality
         if (Txt_Ping)
         {
-            Txt_Ping->SetText(FText::AsNumber(ServerInfo.Ping));
-
-            // Set color based on ping quality
-            FLinearColor PingColor = GetPingColor(ServerInfo.Ping);
-            Txt_Ping->SetColorAndOpacity(FSlateColor(PingColor));
+            Txt_Ping->SetText(Display.Ping);
+            Txt_Ping->SetColorAndOpacity(FSlateColor(Display.PingColor));
         }
 
         // Update ping icon color
         if (Img_PingIcon)
         {
-            FLinearColor PingColor = GetPingColor(ServerInfo.Ping);
-            Img_PingIcon->SetColorAndOpacity(PingColor);
+            Img_PingIcon->SetColorAndOpacity(Display.PingColor);
         }
 
         // Show/hide private icon
@@ -99,105 +90,15 @@ void US_UI_ServerListEntry::NativeOnListItemObjectSet(UObject* ListItemObject)
                 ESlateVisibility::HitTestInvisible : ESlateVisibility::Collapsed);
         }
 
-        UpdateServerStatusVisuals();
-    }
-}
-
-void US_UI_ServerListEntry::UpdateServerStatusVisuals()
-{
-    if (!CachedServerData.IsValid())
-    {
-        return;
-    }
-
-    const F_ServerInfo& ServerInfo = CachedServerData->ServerInfo;
-
-    // Additional visual updates based on server status
-    // For example, you might want to dim full servers or highlight nearly empty ones
-    float WidgetOpacity = 1.0f;
-
-    if (ServerInfo.PlayerCount >= ServerInfo.MaxPlayers)
-    {
-        // Slightly dim full servers
-        WidgetOpacity = 0.7f;
-    }
-    else if (ServerInfo.PlayerCount == 0)
-    {
-        // Slightly dim empty servers
-        WidgetOpacity = 0.8f;
-    }
-
-    SetRenderOpacity(WidgetOpacity);
-}
-
-FText US_UI_ServerListEntry::GetPlayerCountText(int32 CurrentPlayers, int32 MaxPlayers) const
-{
-    return FText::Format(NSLOCTEXT("ServerList", "PlayerCount", "{0}/{1}"),
-        FText::AsNumber(CurrentPlayers),
-        FText::AsNumber(MaxPlayers));
-}
-
-FLinearColor US_UI_ServerListEntry::GetPingColor(int32 Ping) const
-{
-    if (Ping < 50)
-    {
-        // Excellent ping - Green
-        return FLinearColor(0.0f, 1.0f, 0.0f, 1.0f);
-    }
-    else if (Ping < 100)
-    {
-        // Good ping - Yellow-Green
-        return FLinearColor(0.7f, 1.0f, 0.0f, 1.0f);
-    }
-    else if (Ping < 150)
-    {
-        // Moderate ping - Yellow
-        return FLinearColor(1.0f, 1.0f, 0.0f, 1.0f);
-    }
-    else if (Ping < 200)
-    {
-        // Poor ping - Orange
-        return FLinearColor(1.0f, 0.5f, 0.0f, 1.0f);
-    }
-    else
-    {
-        // Very poor ping - Red
-        return FLinearColor(1.0f, 0.0f, 0.0f, 1.0f);
+        // Dim stale, full and empty servers; recycled rows often already have the right opacity
+        if (GetRenderOpacity() != Display.Opacity)
+        {
+            SetRenderOpacity(Display.Opacity);
+        }
     }
 }
 
-FLinearColor US_UI_ServerListEntry::GetServerStatusColor(int32 CurrentPlayers, int32 MaxPlayers) const
+void US_UI_ServerListEntry::RefreshListItem(UObject* ListItemObject)
 {
-    if (MaxPlayers <= 0)
-    {
-        return FLinearColor::White;
-    }
-
-    float FillPercent = (float)CurrentPlayers / (float)MaxPlayers;
-
-    if (FillPercent >= 1.0f)
-    {
-        // Full server - Red
-        return FLinearColor(1.0f, 0.2f, 0.2f, 1.0f);
-    }
-    else if (FillPercent >= 0.75f)
-    {
-        // Nearly full - Orange
-        return FLinearColor(1.0f, 0.6f, 0.0f, 1.0f);
-    }
-    else if (FillPercent >= 0.5f)
-    {
-        // Half full - Yellow
-        return FLinearColor(1.0f, 1.0f, 0.0f, 1.0f);
-    }
-    else if (FillPercent > 0.0f)
-    {
-        // Has players - Green
-        return FLinearColor(0.0f, 1.0f, 0.0f, 1.0f);
-    }
-    else
-    {
-        // Empty - Gray
-        return FLinearColor(0.5f, 0.5f, 0.5f, 1.0f);
-    }
+    NativeOnListItemObjectSet(ListItemObject);
 }
\ No newline at end of file
@@ -1,3 +1,24 @@
 // Plugins/StrafeUI/Source/StrafeUI/Private/UI/S_UI_StringComboBox.cpp
 
-#include "UI/S_UI_StringComboBox.h"
\ No newline at end of file
+#include "UI/S_UI_StringComboBox.h"
+#include "Widgets/Input/SComboBox.h"
+
+bool US_UI_StringComboBox::SetOptionAtIndex(int32 Index, const FString& Option)
+{
+    if (!Options.IsValidIndex(Index))
+    {
+        return false;
+    }
+
+    // The Slate combo box holds the same shared strings, so it only needs to regenerate its rows
+    *Options[Index] = Option;
+    if (MyComboBox.IsValid())
+    {
+        MyComboBox->RefreshOptions();
+    }
+    if (Options[Index] == CurrentOptionPtr)
+    {
+        UpdateOrGenerateWidget(CurrentOptionPtr);
+    }
+    return true;
+}
\ No newline at end of file
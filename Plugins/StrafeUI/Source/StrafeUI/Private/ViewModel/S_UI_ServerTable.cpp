@@ -0,0 +1,641 @@
+// Plugins/StrafeUI/Source/StrafeUI/Private/ViewModel/S_UI_ServerTable.cpp
+
+#include "ViewModel/S_UI_ServerTable.h"
+#include "ViewModel/S_UI_VM_ServerBrowser.h"
+#include "Math/VectorRegister.h"
+#include "Algo/Sort.h"
+#include "Algo/BinarySearch.h"
+#include "Misc/ScopeRWLock.h"
+
+E_ServerFilterChange F_ServerFilterState::Compare(const F_ServerFilterState& OldState, const F_ServerFilterState& NewState)
+{
+	bool bNarrows = true;
+	bool bWidens = true;
+
+	// A query that contains the old query can only match fewer rows, and the reverse
+	auto CompareQuery = [&bNarrows, &bWidens](const FString& OldQuery, const FString& NewQuery)
+	{
+		if (OldQuery == NewQuery)
+		{
+			return;
+		}
+		if (NewQuery.Contains(OldQuery, ESearchCase::CaseSensitive))
+		{
+			bWidens = false;
+		}
+		else if (OldQuery.Contains(NewQuery, ESearchCase::CaseSensitive))
+		{
+			bNarrows = false;
+		}
+		else
+		{
+			bNarrows = bWidens = false;
+		}
+	};
+
+	if (NewState.Numeric.MaxPing < OldState.Numeric.MaxPing)
+	{
+		bWidens = false;
+	}
+	else if (NewState.Numeric.MaxPing > OldState.Numeric.MaxPing)
+	{
+		bNarrows = false;
+	}
+
+	if (EnumHasAnyFlags(NewState.Numeric.RejectFlags, ~OldState.Numeric.RejectFlags))
+	{
+		bWidens = false;
+	}
+	if (EnumHasAnyFlags(OldState.Numeric.RejectFlags, ~NewState.Numeric.RejectFlags))
+	{
+		bNarrows = false;
+	}
+
+	CompareQuery(OldState.LowerServerName, NewState.LowerServerName);
+
+	// Game mode and map are exact matches, so any change to a set value rejects rows the old one accepted
+	auto CompareExact = [&bNarrows, &bWidens](int32 OldId, int32 NewId)
+	{
+		if (OldId == NewId)
+		{
+			return;
+		}
+		if (OldId != INDEX_NONE)
+		{
+			bNarrows = false;
+		}
+		if (NewId != INDEX_NONE)
+		{
+			bWidens = false;
+		}
+	};
+
+	CompareExact(OldState.GameModeId, NewState.GameModeId);
+	CompareExact(OldState.MapId, NewState.MapId);
+
+	// Searching descriptions adds matches for the name query
+	if (OldState.bSearchDescriptions != NewState.bSearchDescriptions && !(OldState.LowerServerName.IsEmpty() && NewState.LowerServerName.IsEmpty()))
+	{
+		if (NewState.bSearchDescriptions)
+		{
+			bNarrows = false;
+		}
+		else
+		{
+			bWidens = false;
+		}
+	}
+
+	if (bNarrows && bWidens)
+	{
+		return E_ServerFilterChange::None;
+	}
+	if (bNarrows)
+	{
+		return E_ServerFilterChange::Narrowed;
+	}
+	return bWidens ? E_ServerFilterChange::Widened : E_ServerFilterChange::Mixed;
+}
+
+bool F_ServerSearchQuery::Includes(const F_ServerSearchQuery& Other) const
+{
+	if ((bNonEmptyOnly && !Other.bNonEmptyOnly) || (bOpenSlotsOnly && !Other.bOpenSlotsOnly))
+	{
+		return false;
+	}
+	if (!GameMode.IsEmpty() && !GameMode.Equals(Other.GameMode, ESearchCase::IgnoreCase))
+	{
+		return false;
+	}
+	return MapName.IsEmpty() || MapName.Equals(Other.MapName, ESearchCase::IgnoreCase);
+}
+
+int32 F_ServerNameTable::Intern(const FString& Value, FText& OutDisplayName)
+{
+	if (Value.IsEmpty())
+	{
+		OutDisplayName = FText::GetEmpty();
+		return INDEX_NONE;
+	}
+
+	// Values repeat across almost every server, so nearly every call ends here
+	{
+		FReadScopeLock ReadLock(Lock);
+		if (const int32* Id = IdsByName.Find(Value))
+		{
+			OutDisplayName = DisplayNames[*Id];
+			return *Id;
+		}
+	}
+
+	FWriteScopeLock WriteLock(Lock);
+
+	// Another thread may have added it between the locks
+	if (const int32* Id = IdsByName.Find(Value))
+	{
+		OutDisplayName = DisplayNames[*Id];
+		return *Id;
+	}
+
+	const int32 Id = DisplayNames.Add(FText::FromString(Value));
+	LowerNames.Add(Value.ToLower());
+	IdsByName.Add(Value, Id);
+	OutDisplayName = DisplayNames[Id];
+	return Id;
+}
+
+int32 F_ServerNameTable::Intern(const FString& Value)
+{
+	FText DisplayName;
+	return Intern(Value, DisplayName);
+}
+
+int32 F_ServerNameTable::Find(const FString& Value) const
+{
+	FReadScopeLock ReadLock(Lock);
+	const int32* Id = IdsByName.Find(Value);
+	return Id ? *Id : INDEX_NONE;
+}
+
+FText F_ServerNameTable::GetDisplayName(int32 Id) const
+{
+	FReadScopeLock ReadLock(Lock);
+	return DisplayNames.IsValidIndex(Id) ? DisplayNames[Id] : FText::GetEmpty();
+}
+
+bool F_ServerNameTable::IsLess(int32 IdA, int32 IdB) const
+{
+	if (IdA == INDEX_NONE || IdB == INDEX_NONE)
+	{
+		return IdA == INDEX_NONE && IdB != INDEX_NONE;
+	}
+
+	FReadScopeLock ReadLock(Lock);
+	return LowerNames[IdA] < LowerNames[IdB];
+}
+
+int32 F_ServerNameTable::Num() const
+{
+	FReadScopeLock ReadLock(Lock);
+	return DisplayNames.Num();
+}
+
+E_ServerRowFlags F_ServerTable::ComputeFlags(const F_ServerInfo& ServerInfo)
+{
+	E_ServerRowFlags RowFlags = E_ServerRowFlags::None;
+
+	if (ServerInfo.bIsPrivate)
+	{
+		RowFlags |= E_ServerRowFlags::Private;
+	}
+	if (ServerInfo.bIsLAN)
+	{
+		RowFlags |= E_ServerRowFlags::LAN;
+	}
+	if (ServerInfo.PlayerCount >= ServerInfo.MaxPlayers)
+	{
+		RowFlags |= E_ServerRowFlags::Full;
+	}
+	if (ServerInfo.PlayerCount == 0)
+	{
+		RowFlags |= E_ServerRowFlags::Empty;
+	}
+	if (ServerInfo.bIsStale)
+	{
+		RowFlags |= E_ServerRowFlags::Stale;
+	}
+
+	return RowFlags;
+}
+
+F_ServerRowText F_ServerRowText::Make(const F_ServerInfo& ServerInfo, const FString& Description)
+{
+	F_ServerRowText RowText;
+	RowText.LowerName = ServerInfo.ServerName.ToString().ToLower();
+	RowText.LowerDescription = Description.ToLower();
+	return RowText;
+}
+
+int32 F_ServerTable::AddRow(const F_ServerInfo& ServerInfo)
+{
+	return AddRow(ServerInfo, F_ServerRowText::Make(ServerInfo));
+}
+
+int32 F_ServerTable::AddRow(const F_ServerInfo& ServerInfo, F_ServerRowText&& RowText)
+{
+	const int32 Row = Pings.Add(ServerInfo.Ping);
+	PlayerCounts.Add(ServerInfo.PlayerCount);
+	MaxPlayers.Add(ServerInfo.MaxPlayers);
+	Flags.Add((int32)ComputeFlags(ServerInfo));
+	GameModeIds.Add(ServerInfo.GameModeId);
+	MapIds.Add(ServerInfo.MapId);
+	LowerNames.Add(MoveTemp(RowText.LowerName));
+	LowerDescriptions.Add(MoveTemp(RowText.LowerDescription));
+	NameIndex.AddRow(Row, LowerNames[Row]);
+	DescriptionIndex.AddRow(Row, LowerDescriptions[Row]);
+	CountRowFacets(Row, 1);
+	return Row;
+}
+
+void F_ServerTable::Reset()
+{
+	Pings.Reset();
+	PlayerCounts.Reset();
+	MaxPlayers.Reset();
+	Flags.Reset();
+	GameModeIds.Reset();
+	MapIds.Reset();
+	LowerNames.Reset();
+	LowerDescriptions.Reset();
+	NameIndex.Reset();
+	DescriptionIndex.Reset();
+
+	// Keep counting revisions so views notice the reset
+	const uint32 FacetRevision = Facets.Revision + 1;
+	Facets = F_ServerFacetCounts();
+	Facets.Revision = FacetRevision;
+
+	for (TArray<int32>& Permutation : SortPermutations)
+	{
+		Permutation.Reset();
+	}
+}
+
+void F_ServerTable::Reserve(int32 NumRows)
+{
+	Pings.Reserve(NumRows);
+	PlayerCounts.Reserve(NumRows);
+	MaxPlayers.Reserve(NumRows);
+	Flags.Reserve(NumRows);
+	GameModeIds.Reserve(NumRows);
+	MapIds.Reserve(NumRows);
+	LowerNames.Reserve(NumRows);
+	LowerDescriptions.Reserve(NumRows);
+}
+
+void F_ServerTable::SetPing(int32 Row, int32 Ping, E_ServerSortColumn ActiveColumn, bool bActiveDescending)
+{
+	if (Pings[Row] == Ping)
+	{
+		return;
+	}
+
+	Pings[Row] = Ping;
+
+	// Every column uses ping as a primary or secondary key. Only the order in use is worth a linear move per reply;
+	// the rest are rebuilt if the user switches to them.
+	for (int32 ColumnIndex = 1; ColumnIndex < (int32)E_ServerSortColumn::Count; ++ColumnIndex)
+	{
+		for (const bool bDescending : { false, true })
+		{
+			const E_ServerSortColumn Column = (E_ServerSortColumn)ColumnIndex;
+			TArray<int32>& Permutation = SortPermutations[GetPermutationIndex(Column, bDescending)];
+			if (Column != ActiveColumn || bDescending != bActiveDescending)
+			{
+				Permutation.Reset();
+				continue;
+			}
+
+			// Rows not sorted yet are placed when the permutation is next brought up to date
+			if (Row < Permutation.Num())
+			{
+				Permutation.RemoveSingle(Row);
+				const int32 Index = Algo::LowerBound(Permutation, Row, [this, Column, bDescending](int32 RowA, int32 RowB) { return IsRowLess(Column, bDescending, RowA, RowB); });
+				Permutation.Insert(Row, Index);
+			}
+		}
+	}
+}
+
+F_ServerRowText F_ServerTable::GetRowText(int32 Row) const
+{
+	F_ServerRowText RowText;
+	RowText.LowerName = LowerNames[Row];
+	RowText.LowerDescription = LowerDescriptions[Row];
+	return RowText;
+}
+
+bool F_ServerTable::HasSameText(int32 Row, const F_ServerRowText& RowText) const
+{
+	return LowerNames[Row] == RowText.LowerName && LowerDescriptions[Row] == RowText.LowerDescription;
+}
+
+bool F_ServerTable::UpdateNumeric(int32 Row, const F_ServerInfo& ServerInfo)
+{
+	// Keep the superseded bit; it belongs to the table rather than the server
+	const int32 RowFlags = (int32)ComputeFlags(ServerInfo) | (Flags[Row] & (int32)E_ServerRowFlags::Superseded);
+
+	if (Pings[Row] == ServerInfo.Ping && PlayerCounts[Row] == ServerInfo.PlayerCount
+		&& MaxPlayers[Row] == ServerInfo.MaxPlayers && Flags[Row] == RowFlags
+		&& GameModeIds[Row] == ServerInfo.GameModeId && MapIds[Row] == ServerInfo.MapId)
+	{
+		return false;
+	}
+
+	// Move the row between facets; superseded rows are not counted
+	const bool bCounted = (RowFlags & (int32)E_ServerRowFlags::Superseded) == 0;
+	if (bCounted)
+	{
+		CountRowFacets(Row, -1);
+	}
+
+	Pings[Row] = ServerInfo.Ping;
+	PlayerCounts[Row] = ServerInfo.PlayerCount;
+	MaxPlayers[Row] = ServerInfo.MaxPlayers;
+	Flags[Row] = RowFlags;
+	GameModeIds[Row] = ServerInfo.GameModeId;
+	MapIds[Row] = ServerInfo.MapId;
+
+	if (bCounted)
+	{
+		CountRowFacets(Row, 1);
+	}
+
+	// Ping and player count are sort keys
+	for (TArray<int32>& Permutation : SortPermutations)
+	{
+		Permutation.Reset();
+	}
+	return true;
+}
+
+void F_ServerTable::MarkSuperseded(int32 Row)
+{
+	if ((Flags[Row] & (int32)E_ServerRowFlags::Superseded) == 0)
+	{
+		CountRowFacets(Row, -1);
+		Flags[Row] |= (int32)E_ServerRowFlags::Superseded;
+	}
+}
+
+void F_ServerTable::CountFlagFacets(int32 RowFlags, int32 Delta)
+{
+	Facets.NumFull += (RowFlags & (int32)E_ServerRowFlags::Full) != 0 ? Delta : 0;
+	Facets.NumEmpty += (RowFlags & (int32)E_ServerRowFlags::Empty) != 0 ? Delta : 0;
+	Facets.NumPrivate += (RowFlags & (int32)E_ServerRowFlags::Private) != 0 ? Delta : 0;
+}
+
+void F_ServerTable::CountRowFacets(int32 Row, int32 Delta)
+{
+	auto CountValue = [Delta](TArray<int32>& Counts, int32 Id)
+	{
+		if (Id != INDEX_NONE)
+		{
+			if (Id >= Counts.Num())
+			{
+				Counts.SetNumZeroed(Id + 1);
+			}
+			Counts[Id] += Delta;
+		}
+	};
+
+	CountValue(Facets.GameModeCounts, GameModeIds[Row]);
+	CountValue(Facets.MapCounts, MapIds[Row]);
+	CountFlagFacets(Flags[Row], Delta);
+	Facets.NumServers += Delta;
+	++Facets.Revision;
+}
+
+const TArray<int32>& F_ServerTable::GetSortPermutation(E_ServerSortColumn Column, bool bDescending)
+{
+	TArray<int32>& Permutation = SortPermutations[GetPermutationIndex(Column, bDescending)];
+
+	const int32 NumSorted = Permutation.Num();
+	const int32 NumRows = Num();
+	if (NumSorted == NumRows)
+	{
+		return Permutation;
+	}
+
+	auto RowLess = [this, Column, bDescending](int32 RowA, int32 RowB) { return IsRowLess(Column, bDescending, RowA, RowB); };
+
+	// Sort only the rows added since the permutation was last brought up to date
+	TArray<int32> NewRows;
+	NewRows.Reserve(NumRows - NumSorted);
+	for (int32 Row = NumSorted; Row < NumRows; ++Row)
+	{
+		NewRows.Add(Row);
+	}
+
+	if (Column != E_ServerSortColumn::None)
+	{
+		Algo::Sort(NewRows, RowLess);
+	}
+
+	if (NumSorted == 0)
+	{
+		Permutation = MoveTemp(NewRows);
+		return Permutation;
+	}
+
+	// Merge the sorted new rows into the existing permutation in a single linear pass
+	TArray<int32> Merged;
+	Merged.Reserve(NumRows);
+
+	int32 OldIndex = 0;
+	int32 NewIndex = 0;
+	while (OldIndex < NumSorted && NewIndex < NewRows.Num())
+	{
+		if (RowLess(NewRows[NewIndex], Permutation[OldIndex]))
+		{
+			Merged.Add(NewRows[NewIndex++]);
+		}
+		else
+		{
+			Merged.Add(Permutation[OldIndex++]);
+		}
+	}
+	Merged.Append(Permutation.GetData() + OldIndex, NumSorted - OldIndex);
+	Merged.Append(NewRows.GetData() + NewIndex, NewRows.Num() - NewIndex);
+
+	Permutation = MoveTemp(Merged);
+	return Permutation;
+}
+
+bool F_ServerTable::IsRowLess(E_ServerSortColumn Column, bool bDescending, int32 RowA, int32 RowB) const
+{
+	// Compares one key; returns true if it decided the order, writing the result to bOutLess
+	auto CompareKey = [](const auto& A, const auto& B, bool& bOutLess)
+	{
+		if (A < B)
+		{
+			bOutLess = true;
+			return true;
+		}
+		if (B < A)
+		{
+			bOutLess = false;
+			return true;
+		}
+		return false;
+	};
+
+	// Interned values order by their text; different IDs never have equal text
+	auto CompareName = [](const F_ServerNameTable& Names, int32 IdA, int32 IdB, bool& bOutLess)
+	{
+		if (IdA == IdB)
+		{
+			return false;
+		}
+		bOutLess = Names.IsLess(IdA, IdB);
+		return true;
+	};
+
+	// Only the primary key follows the sort direction; ties keep breaking the same way either way
+	bool bLess = false;
+	bool bPrimaryDecided = false;
+	switch (Column)
+	{
+	case E_ServerSortColumn::Ping:
+		bPrimaryDecided = CompareKey(Pings[RowA], Pings[RowB], bLess);
+		break;
+
+	case E_ServerSortColumn::Players:
+		bPrimaryDecided = CompareKey(PlayerCounts[RowA], PlayerCounts[RowB], bLess);
+		break;
+
+	case E_ServerSortColumn::Name:
+		bPrimaryDecided = CompareKey(LowerNames[RowA], LowerNames[RowB], bLess);
+		break;
+
+	case E_ServerSortColumn::Map:
+		bPrimaryDecided = CompareName(*MapNames, MapIds[RowA], MapIds[RowB], bLess);
+		break;
+
+	case E_ServerSortColumn::GameMode:
+		bPrimaryDecided = CompareName(*GameModeNames, GameModeIds[RowA], GameModeIds[RowB], bLess);
+		break;
+
+	default:
+		return RowA < RowB;
+	}
+
+	if (bPrimaryDecided)
+	{
+		return bLess != bDescending;
+	}
+
+	// Ping breaks ties, except for the ping column itself which falls back to the name
+	const bool bSecondaryDecided = (Column == E_ServerSortColumn::Ping)
+		? CompareKey(LowerNames[RowA], LowerNames[RowB], bLess)
+		: CompareKey(Pings[RowA], Pings[RowB], bLess);
+	if (bSecondaryDecided)
+	{
+		return bLess;
+	}
+
+	// Row order as the final key keeps every permutation a strict total order
+	return RowA < RowB;
+}
+
+void F_ServerTable::FilterNumeric(const F_ServerNumericFilter& Filter, int32 FirstRow, TArray<uint32>& InOutSelection) const
+{
+	const int32 NumRows = Num();
+	InOutSelection.SetNumZeroed(FMath::DivideAndRoundUp(NumRows, 32));
+
+	const int32 RejectFlags = (int32)Filter.RejectFlags;
+	const int32* PingData = Pings.GetData();
+	const int32* FlagData = Flags.GetData();
+	uint32* Words = InOutSelection.GetData();
+
+	// Scalar, branch-free evaluation of a single row
+	auto EvaluateRow = [&](int32 Row)
+	{
+		const uint32 bPasses = (uint32)(PingData[Row] <= Filter.MaxPing) & (uint32)((FlagData[Row] & RejectFlags) == 0);
+		const uint32 Bit = 1u << (Row & 31);
+		Words[Row >> 5] = (Words[Row >> 5] & ~Bit) | (bPasses << (Row & 31));
+	};
+
+	int32 Row = FirstRow;
+
+	// Evaluate single rows until the next group of four starts on a 4-row boundary
+	for (; Row < NumRows && (Row & 3) != 0; ++Row)
+	{
+		EvaluateRow(Row);
+	}
+
+	const VectorRegister4Int MaxPingVec = VectorIntSet1(Filter.MaxPing);
+	const VectorRegister4Int RejectVec = VectorIntSet1(RejectFlags);
+	const VectorRegister4Int ZeroVec = VectorIntSet1(0);
+
+	// Four rows per iteration. A group never straddles a bitmap word because groups start on 4-row boundaries.
+	for (; Row + 4 <= NumRows; Row += 4)
+	{
+		const VectorRegister4Int PingVec = VectorIntLoad(PingData + Row);
+		const VectorRegister4Int FlagVec = VectorIntLoad(FlagData + Row);
+
+		const VectorRegister4Int PingPasses = VectorIntCompareLE(PingVec, MaxPingVec);
+		const VectorRegister4Int FlagsPass = VectorIntCompareEQ(VectorIntAnd(FlagVec, RejectVec), ZeroVec);
+		const VectorRegister4Int RowPasses = VectorIntAnd(PingPasses, FlagsPass);
+
+		const uint32 Mask = (uint32)VectorMaskBits(VectorCastIntToFloat(RowPasses));
+		const uint32 Shift = Row & 31;
+		Words[Row >> 5] = (Words[Row >> 5] & ~(0xFu << Shift)) | (Mask << Shift);
+	}
+
+	// Remaining rows
+	for (; Row < NumRows; ++Row)
+	{
+		EvaluateRow(Row);
+	}
+}
+
+float F_ServerTable::ScoreRow(const F_ServerScoreWeights& Weights, int32 Row) const
+{
+	const float FillRatio = MaxPlayers[Row] > 0 ? (float)PlayerCounts[Row] / (float)MaxPlayers[Row] : 0.0f;
+	float Score = Weights.FillWeight * FillRatio - Weights.PingWeight * (float)Pings[Row];
+
+	if (Weights.PreferredGameModeId != INDEX_NONE && GameModeIds[Row] == Weights.PreferredGameModeId)
+	{
+		Score += Weights.GameModeBonus;
+	}
+	return Score;
+}
+
+void F_ServerTable::SelectBestRows(const TArray<uint32>& Selection, const F_ServerScoreWeights& Weights, int32 Count, TArray<int32>& OutRows) const
+{
+	OutRows.Reset();
+	if (Count <= 0)
+	{
+		return;
+	}
+
+	struct FScoredRow
+	{
+		float Score;
+		int32 Row;
+	};
+
+	// Min-heap of the best rows so far; the root is the weakest and the first to be displaced
+	TArray<FScoredRow, TInlineAllocator<16>> Best;
+	const auto IsWeaker = [](const FScoredRow& A, const FScoredRow& B) { return A.Score < B.Score; };
+	const int32 UnjoinableFlags = (int32)(E_ServerRowFlags::Private | E_ServerRowFlags::Full | E_ServerRowFlags::Stale | E_ServerRowFlags::Superseded);
+
+	ForEachSelected(Selection, 0, [this, &Weights, Count, &Best, &IsWeaker, UnjoinableFlags](int32 Row)
+	{
+		if ((Flags[Row] & UnjoinableFlags) != 0)
+		{
+			return;
+		}
+
+		const float Score = ScoreRow(Weights, Row);
+		if (Best.Num() < Count)
+		{
+			Best.HeapPush({ Score, Row }, IsWeaker);
+		}
+		else if (Score > Best.HeapTop().Score)
+		{
+			Best.HeapPopDiscard(IsWeaker, EAllowShrinking::No);
+			Best.HeapPush({ Score, Row }, IsWeaker);
+		}
+	});
+
+	// Only the survivors need a full ordering
+	Best.Sort([](const FScoredRow& A, const FScoredRow& B) { return A.Score > B.Score; });
+
+	OutRows.Reserve(Best.Num());
+	for (const FScoredRow& ScoredRow : Best)
+	{
+		OutRows.Add(ScoredRow.Row);
+	}
+}
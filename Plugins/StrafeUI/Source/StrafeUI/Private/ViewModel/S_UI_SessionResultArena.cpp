@@ -0,0 +1,47 @@
+// Plugins/StrafeUI/Source/StrafeUI/Private/ViewModel/S_UI_SessionResultArena.cpp
+
+#include "ViewModel/S_UI_SessionResultArena.h"
+#include "OnlineSessionSettings.h"
+
+void F_SessionResultArena::Reset()
+{
+	Searches.Reset();
+
+	if (++Generation == 0)
+	{
+		Generation = 1;
+	}
+}
+
+int32 F_SessionResultArena::AddSearch(const TSharedRef<FOnlineSessionSearch>& Search)
+{
+	return Searches.Add(Search);
+}
+
+void F_SessionResultArena::ReleaseSearchesBefore(int32 FirstKept)
+{
+	for (int32 SearchIndex = 0; SearchIndex < FMath::Min(FirstKept, Searches.Num()); ++SearchIndex)
+	{
+		Searches[SearchIndex].Reset();
+	}
+}
+
+F_SessionResultHandle F_SessionResultArena::MakeHandle(int32 SearchIndex, int32 ResultIndex) const
+{
+	F_SessionResultHandle Handle;
+	Handle.Generation = Generation;
+	Handle.SearchIndex = SearchIndex;
+	Handle.ResultIndex = ResultIndex;
+	return Handle;
+}
+
+const FOnlineSessionSearchResult* F_SessionResultArena::Resolve(const F_SessionResultHandle& Handle) const
+{
+	if (Handle.Generation != Generation || !Searches.IsValidIndex(Handle.SearchIndex) || !Searches[Handle.SearchIndex].IsValid())
+	{
+		return nullptr;
+	}
+
+	const TArray<FOnlineSessionSearchResult>& Results = Searches[Handle.SearchIndex]->SearchResults;
+	return Results.IsValidIndex(Handle.ResultIndex) ? &Results[Handle.ResultIndex] : nullptr;
+}
\ No newline at end of file
@@ -0,0 +1,95 @@
+// Plugins/StrafeUI/Source/StrafeUI/Private/ViewModel/S_UI_TrigramIndex.cpp
+
+#include "ViewModel/S_UI_TrigramIndex.h"
+#include "Algo/BinarySearch.h"
+
+void F_TrigramIndex::AddRow(int32 Row, const FString& LowerText)
+{
+	const TCHAR* Chars = *LowerText;
+	for (int32 Index = 0; Index + MinQueryLength <= LowerText.Len(); ++Index)
+	{
+		TArray<int32>& Rows = Postings.FindOrAdd(MakeTrigram(Chars + Index));
+
+		// A trigram can repeat within one text; rows are added in order so only the tail needs checking
+		if (Rows.Num() == 0 || Rows.Last() != Row)
+		{
+			Rows.Add(Row);
+		}
+	}
+}
+
+void F_TrigramIndex::Reset()
+{
+	Postings.Reset();
+}
+
+bool F_TrigramIndex::FindCandidates(const FString& LowerQuery, int32 FirstRow, TArray<int32>& OutRows) const
+{
+	OutRows.Reset();
+
+	if (LowerQuery.Len() < MinQueryLength)
+	{
+		return false;
+	}
+
+	// Gather the posting list of every distinct trigram in the query
+	TArray<const TArray<int32>*, TInlineAllocator<16>> Lists;
+	TSet<uint64, DefaultKeyFuncs<uint64>, TInlineSetAllocator<16>> SeenTrigrams;
+
+	const TCHAR* Chars = *LowerQuery;
+	for (int32 Index = 0; Index + MinQueryLength <= LowerQuery.Len(); ++Index)
+	{
+		const uint64 Trigram = MakeTrigram(Chars + Index);
+		bool bAlreadySeen = false;
+		SeenTrigrams.Add(Trigram, &bAlreadySeen);
+		if (bAlreadySeen)
+		{
+			continue;
+		}
+
+		const TArray<int32>* Rows = Postings.Find(Trigram);
+		if (!Rows)
+		{
+			// No row contains this trigram, so no row can contain the query
+			return true;
+		}
+		Lists.Add(Rows);
+	}
+
+	// Intersect starting from the shortest list so the working set is as small as possible
+	Lists.Sort([](const TArray<int32>& A, const TArray<int32>& B) { return A.Num() < B.Num(); });
+
+	const TArray<int32>& Shortest = *Lists[0];
+	for (int32 Index = Algo::LowerBound(Shortest, FirstRow); Index < Shortest.Num(); ++Index)
+	{
+		OutRows.Add(Shortest[Index]);
+	}
+
+	TArray<int32> Intersection;
+	for (int32 ListIndex = 1; ListIndex < Lists.Num() && OutRows.Num() > 0; ++ListIndex)
+	{
+		const TArray<int32>& Other = *Lists[ListIndex];
+		Intersection.Reset();
+
+		int32 OtherIndex = Algo::LowerBound(Other, OutRows[0]);
+		for (const int32 Row : OutRows)
+		{
+			while (OtherIndex < Other.Num() && Other[OtherIndex] < Row)
+			{
+				++OtherIndex;
+			}
+			if (OtherIndex == Other.Num())
+			{
+				break;
+			}
+			if (Other[OtherIndex] == Row)
+			{
+				Intersection.Add(Row);
+			}
+		}
+
+		Swap(OutRows, Intersection);
+	}
+
+	return true;
+}
\ No newline at end of file
@@ -3,12 +3,18 @@
 #include "ViewModel/S_UI_VM_CreateGame.h"
 #include "S_UI_Settings.h"
 #include "S_UI_Subsystem.h"
+#include "S_UI_OnlineSessionManager.h"
 #include "Kismet/GameplayStatics.h"
 #include "OnlineSubsystem.h"
 #include "OnlineSessionSettings.h"
 #include "Interfaces/OnlineSessionInterface.h"
 #include "Engine/World.h"
 #include "Data/S_UI_ScreenTypes.h"
+#include "Services/S_JoinTrace.h"
+#include "S_UI_AssetManager.h"
+#include "Engine/AssetManager.h"
+#include "Misc/ScopeExit.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
 
 // Define custom session settings keys
 #define SETTING_GAMEMODE FName(TEXT("GAMEMODE"))
@@ -49,84 +55,74 @@ void US_UI_VM_CreateGame::Initialize(const US_UI_Settings* InSettings)
 
 void US_UI_VM_CreateGame::CreateGame()
 {
-	// Get the Session Interface
-	IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get();
-	if (!OnlineSubsystem)
-	{
-		UE_LOG(LogTemp, Error, TEXT("CreateGame failed: No online subsystem found"));
-		return;
-	}
+	F_JoinTrace::Begin(E_JoinTraceFlow::CreateGame, SelectedMapName);
 
-	IOnlineSessionPtr SessionInterface = OnlineSubsystem->GetSessionInterface();
-	if (!SessionInterface.IsValid())
+	// Get the Session Manager
+	US_UI_OnlineSessionManager* SessionManager = GetSessionManager();
+	if (!SessionManager || !SessionManager->GetSessionInterface().IsValid())
 	{
 		UE_LOG(LogTemp, Error, TEXT("CreateGame failed: Session interface is invalid"));
+		F_JoinTrace::End(false, TEXT("NoSessionInterface"));
 		return;
 	}
 
-	// Check if a session already exists
-	if (SessionInterface->GetNamedSession(NAME_GameSession))
-	{
-		UE_LOG(LogTemp, Log, TEXT("Found an existing session. Destroying it before creating a new one."));
-
-		// Bind the completion delegate
-		DestroySessionCompleteDelegateHandle = SessionInterface->AddOnDestroySessionCompleteDelegate_Handle(
-			FOnDestroySessionCompleteDelegate::CreateUObject(this, &US_UI_VM_CreateGame::OnDestroySessionComplete)
-		);
+	// Make sure the selection is loading so it overlaps any session teardown below
+	PrefetchSelection();
 
-		// Destroy the existing session
-		if (!SessionInterface->DestroySession(NAME_GameSession))
-		{
-			// If the call fails, clear the delegate and log an error
-			SessionInterface->ClearOnDestroySessionCompleteDelegate_Handle(DestroySessionCompleteDelegateHandle);
-			UE_LOG(LogTemp, Error, TEXT("Failed to submit session destroy request."));
-		}
-	}
-	else
+	// Destroy any existing session first; this succeeds straight away when there is none
+	if (SessionManager->IsInSession())
 	{
-		// If no session exists, proceed directly to creation
-		CreateNewSession();
+		UE_LOG(LogTemp, Log, TEXT("Found an existing session. Destroying it before creating a new one."));
 	}
+	F_JoinTrace::BeginPhase(TEXT("SessionQueue"));
+
+	F_SessionOperation Operation;
+	Operation.DebugName = TEXT("Destroy session before create");
+	Operation.SubsystemName = SessionManager->GetCurrentSessionSubsystemName();
+	Operation.Steps.Add(F_SessionStep::Make(E_SessionStepType::Destroy));
+	Operation.CoalesceKey = TEXT("CreateGameDestroySession");
+	Operation.bTraceSteps = true;
+	Operation.OnComplete.BindUObject(this, &US_UI_VM_CreateGame::OnDestroySessionComplete);
+	SessionManager->SubmitOperation(MoveTemp(Operation));
 }
 
-void US_UI_VM_CreateGame::OnDestroySessionComplete(FName SessionName, bool bWasSuccessful)
+void US_UI_VM_CreateGame::OnDestroySessionComplete(const F_SessionOperationReport& Report)
 {
-	// Clean up the delegate
-	IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get();
-	if (OnlineSubsystem)
+	if (Report.Succeeded())
 	{
-		IOnlineSessionPtr SessionInterface = OnlineSubsystem->GetSessionInterface();
-		if (SessionInterface.IsValid())
-		{
-			SessionInterface->ClearOnDestroySessionCompleteDelegate_Handle(DestroySessionCompleteDelegateHandle);
-		}
-	}
-
-	if (bWasSuccessful)
-	{
-		UE_LOG(LogTemp, Log, TEXT("Successfully destroyed previous session."));
 		// Now that the old session is gone, create the new one.
 		CreateNewSession();
 	}
-	else
+	else if (Report.Result != E_SessionOperationResult::Superseded)
 	{
 		UE_LOG(LogTemp, Warning, TEXT("Failed to destroy previous session."));
+		F_JoinTrace::End(false, TEXT("DestroySessionFailed"));
 	}
 }
 
 void US_UI_VM_CreateGame::CreateNewSession()
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(US_UI_VM_CreateGame::CreateNewSession);
+
+	// Every early return below ends the attempt; only a submitted session, or one waiting on its game mode, keeps the trace open
+	bool bSessionSubmitted = false;
+	ON_SCOPE_EXIT
+	{
+		if (!bSessionSubmitted)
+		{
+			F_JoinTrace::End(false, TEXT("CreateSessionFailed"));
+		}
+	};
+
+	const bool bResumedAfterLoad = bWaitingForGameModeClass;
+	bWaitingForGameModeClass = false;
+
 	if (!UISettings.IsValid()) return;
 
 	// This function now contains the logic that was originally in CreateGame()
 
 	// Find the full GameModeInfo struct from the selected display name
-	const FStrafeGameModeInfo* SelectedGameModeInfo = UISettings->AvailableGameModes.FindByPredicate(
-		[this](const FStrafeGameModeInfo& Info)
-		{
-			return Info.DisplayName.ToString() == SelectedGameModeName;
-		});
-
+	const FStrafeGameModeInfo* SelectedGameModeInfo = FindSelectedGameModeInfo();
 	if (!SelectedGameModeInfo)
 	{
 		UE_LOG(LogTemp, Error, TEXT("CreateGame failed: Could not find settings for selected game mode '%s'"), *SelectedGameModeName);
@@ -134,41 +130,43 @@ void US_UI_VM_CreateGame::CreateNewSession()
 	}
 
 	// Find the map asset from the selected map display name
-	const TSoftObjectPtr<UWorld>* SelectedMapAsset = SelectedGameModeInfo->CompatibleMaps.FindByPredicate(
-		[this](const TSoftObjectPtr<UWorld>& MapAsset)
-		{
-			// Get the asset name from the soft pointer path
-			return FPaths::GetBaseFilename(MapAsset.ToString()) == SelectedMapName;
-		});
-
+	const TSoftObjectPtr<UWorld>* SelectedMapAsset = FindSelectedMapAsset(*SelectedGameModeInfo);
 	if (!SelectedMapAsset || SelectedMapAsset->IsNull())
 	{
 		UE_LOG(LogTemp, Error, TEXT("CreateGame failed: Could not find asset for selected map '%s'"), *SelectedMapName);
 		return;
 	}
 
-	CachedGameModeClass = SelectedGameModeInfo->GameModeClass.LoadSynchronous();
-	if (!CachedGameModeClass)
+	// The game mode class has usually been loading since it was selected; wait for it rather than loading it synchronously.
+	// A selection change while waiting cancels the load, which brings us back here for the new selection.
+	if (!bResumedAfterLoad)
 	{
-		UE_LOG(LogTemp, Error, TEXT("CreateGame failed: Could not load GameModeClass asset"));
+		F_JoinTrace::BeginPhase(TEXT("LoadGameMode"));
+	}
+	PrefetchSelection();
+	if (GameModeClassHandle.IsValid() && GameModeClassHandle->IsLoadingInProgress())
+	{
+		bWaitingForGameModeClass = true;
+		bSessionSubmitted = true;
+		GameModeClassHandle->BindCompleteDelegate(FStreamableDelegate::CreateUObject(this, &US_UI_VM_CreateGame::ResumeCreateNewSession));
+		GameModeClassHandle->BindCancelDelegate(FStreamableDelegate::CreateUObject(this, &US_UI_VM_CreateGame::ResumeCreateNewSession));
 		return;
 	}
 
-	CachedMapAssetPath = (*SelectedMapAsset).ToSoftObjectPath().GetLongPackageName();
-
-	// Get the Online Subsystem
-	IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get();
-	if (!OnlineSubsystem)
+	CachedGameModeClass = SelectedGameModeInfo->GameModeClass.Get();
+	if (!CachedGameModeClass)
 	{
-		UE_LOG(LogTemp, Error, TEXT("CreateGame failed: No online subsystem found"));
+		UE_LOG(LogTemp, Error, TEXT("CreateGame failed: Could not load GameModeClass asset"));
 		return;
 	}
 
-	// Get the Session Interface
-	IOnlineSessionPtr SessionInterface = OnlineSubsystem->GetSessionInterface();
-	if (!SessionInterface.IsValid())
+	CachedMapAssetPath = (*SelectedMapAsset).ToSoftObjectPath().GetLongPackageName();
+
+	// Get the Session Manager
+	US_UI_OnlineSessionManager* SessionManager = GetSessionManager();
+	if (!SessionManager)
 	{
-		UE_LOG(LogTemp, Error, TEXT("CreateGame failed: Session interface is invalid"));
+		UE_LOG(LogTemp, Error, TEXT("CreateGame failed: No session manager"));
 		return;
 	}
 
@@ -188,7 +186,7 @@ void US_UI_VM_CreateGame::CreateNewSession()
 	}
 
 	// Create the session settings
-	TSharedPtr<FOnlineSessionSettings> SessionSettings = MakeShareable(new FOnlineSessionSettings());
+	TSharedRef<FOnlineSessionSettings> SessionSettings = MakeShared<FOnlineSessionSettings>();
 
 	// Basic settings
 	SessionSettings->NumPublicConnections = MaxPlayers;
@@ -236,109 +234,73 @@ void US_UI_VM_CreateGame::CreateNewSession()
 	UE_LOG(LogTemp, Log, TEXT("-----------------------------------------"));
 
 
-	// Bind the completion delegate
-	CreateSessionCompleteDelegateHandle = SessionInterface->AddOnCreateSessionCompleteDelegate_Handle(
-		FOnCreateSessionCompleteDelegate::CreateUObject(this, &US_UI_VM_CreateGame::OnCreateSessionComplete)
-	);
-
-	// Create the session
-	const ULocalPlayer* LocalPlayer = PC->GetLocalPlayer();
-	if (!SessionInterface->CreateSession(*LocalPlayer->GetPreferredUniqueNetId(), NAME_GameSession, *SessionSettings))
-	{
-		UE_LOG(LogTemp, Error, TEXT("CreateGame failed: Failed to create session"));
-
-		// Clean up the delegate since we won't get a callback
-		SessionInterface->ClearOnCreateSessionCompleteDelegate_Handle(CreateSessionCompleteDelegateHandle);
-
-		// Show error modal
-		if (UWorld* WorldContext = GetWorld())
-		{
-			if (US_UI_Subsystem* UISubsystem = WorldContext->GetGameInstance()->GetSubsystem<US_UI_Subsystem>())
-			{
-				F_UIModalPayload Payload;
-				Payload.Message = FText::FromString(TEXT("Failed to create game session. Please try again."));
-				Payload.ModalType = E_UIModalType::OK;
-				UISubsystem->RequestModal(Payload, FOnModalDismissedSignature());
-			}
-		}
-	}
-}
-
-void US_UI_VM_CreateGame::OnCreateSessionComplete(FName SessionName, bool bWasSuccessful)
-{
-	IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get();
-	if (OnlineSubsystem)
-	{
-		IOnlineSessionPtr SessionInterface = OnlineSubsystem->GetSessionInterface();
-		if (SessionInterface.IsValid())
-		{
-			// Clean up the delegate regardless of success
-			SessionInterface->ClearOnCreateSessionCompleteDelegate_Handle(CreateSessionCompleteDelegateHandle);
-
-			if (bWasSuccessful)
-			{
-				UE_LOG(LogTemp, Log, TEXT("Session '%s' created successfully. Starting session..."), *SessionName.ToString());
-
-				// Bind the start session delegate
-				StartSessionCompleteDelegateHandle = SessionInterface->AddOnStartSessionCompleteDelegate_Handle(
-					FOnStartSessionCompleteDelegate::CreateUObject(this, &US_UI_VM_CreateGame::OnStartSessionComplete)
-				);
-
-				// Start the session
-				if (!SessionInterface->StartSession(SessionName))
-				{
-					UE_LOG(LogTemp, Error, TEXT("Failed to start session."));
-					SessionInterface->ClearOnStartSessionCompleteDelegate_Handle(StartSessionCompleteDelegateHandle);
-				}
-			}
-			else
-			{
-				UE_LOG(LogTemp, Error, TEXT("Failed to create session"));
-
-				// Show error modal
-				if (UWorld* World = GetWorld())
-				{
-					if (US_UI_Subsystem* UISubsystem = World->GetGameInstance()->GetSubsystem<US_UI_Subsystem>())
-					{
-						F_UIModalPayload Payload;
-						Payload.Message = FText::FromString(TEXT("Failed to create game session. Please check your connection and try again."));
-						Payload.ModalType = E_UIModalType::OK;
-						UISubsystem->RequestModal(Payload, FOnModalDismissedSignature());
-					}
-				}
-			}
-		}
-	}
+	// Create and start the session as one queued operation; a call that cannot start is reported through OnCreateSessionComplete
+	F_SessionOperation Operation;
+	Operation.DebugName = TEXT("Create game session");
+	// LAN games are hosted where the server browser searches for them
+	Operation.SubsystemName = bIsLANMatch ? US_UI_OnlineSessionManager::GetLANSubsystemName() : NAME_None;
+	Operation.UserId = PC->GetLocalPlayer()->GetPreferredUniqueNetId().GetUniqueNetId();
+	Operation.Steps.Add(F_SessionStep::MakeCreate(SessionSettings));
+	Operation.Steps.Add(F_SessionStep::Make(E_SessionStepType::Start));
+	Operation.CoalesceKey = TEXT("CreateGameSession");
+	Operation.bTraceSteps = true;
+	Operation.OnComplete.BindUObject(this, &US_UI_VM_CreateGame::OnCreateSessionComplete);
+
+	bSessionSubmitted = true;
+	SessionManager->SubmitOperation(MoveTemp(Operation));
 }
 
-void US_UI_VM_CreateGame::OnStartSessionComplete(FName SessionName, bool bWasSuccessful)
+void US_UI_VM_CreateGame::OnCreateSessionComplete(const F_SessionOperationReport& Report)
 {
-	IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get();
-	if (OnlineSubsystem)
+	if (Report.Result == E_SessionOperationResult::Superseded)
 	{
-		IOnlineSessionPtr SessionInterface = OnlineSubsystem->GetSessionInterface();
-		if (SessionInterface.IsValid())
-		{
-			// Clean up the delegate
-			SessionInterface->ClearOnStartSessionCompleteDelegate_Handle(StartSessionCompleteDelegateHandle);
-		}
+		return;
 	}
 
-	if (bWasSuccessful)
+	if (Report.Succeeded())
 	{
-		UE_LOG(LogTemp, Log, TEXT("Session '%s' started successfully. Traveling to map..."), *SessionName.ToString());
+		UE_LOG(LogTemp, Log, TEXT("Session '%s' created and started successfully. Traveling to map..."), *Report.SessionName.ToString());
 
 		// Travel to the map as a listen server
 		UWorld* World = GetWorld();
 		if (World && CachedGameModeClass)
 		{
 			FString TravelURL = FString::Printf(TEXT("%s?listen?game=%s"), *CachedMapAssetPath, *CachedGameModeClass->GetPathName());
+
+			// Travel collects this view model before the map loads; keep the prefetched map until it has
+			US_UI_AssetManager::KeepLoadedUntilNextMap(MoveTemp(MapHandle));
+			MapHandle.Reset();
+			MapPath.Reset();
+
+			F_JoinTrace::BeginTravel();
 			World->ServerTravel(TravelURL);
 		}
+		else
+		{
+			F_JoinTrace::End(false, TEXT("NoWorld"));
+		}
 	}
-	else
+	else if (Report.Steps.Num() > 0 && Report.Steps.Last().Type == E_SessionStepType::Start)
 	{
 		UE_LOG(LogTemp, Error, TEXT("Failed to start session."));
+		F_JoinTrace::End(false, TEXT("StartSessionFailed"));
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to create session"));
+		F_JoinTrace::End(false, TEXT("CreateSessionFailed"));
+
+		// Show error modal
+		if (UWorld* World = GetWorld())
+		{
+			if (US_UI_Subsystem* UISubsystem = World->GetGameInstance()->GetSubsystem<US_UI_Subsystem>())
+			{
+				F_UIModalPayload Payload;
+				Payload.Message = FText::FromString(TEXT("Failed to create game session. Please check your connection and try again."));
+				Payload.ModalType = E_UIModalType::OK;
+				UISubsystem->RequestModal(Payload, FOnModalDismissedSignature());
+			}
+		}
 	}
 }
 
@@ -351,11 +313,7 @@ void US_UI_VM_CreateGame::OnGameModeChanged(FString InSelectedGameModeName)
 	if (!UISettings.IsValid()) return;
 
 	// Find the game mode info struct that matches the new selection
-	const FStrafeGameModeInfo* GameModeInfo = UISettings->AvailableGameModes.FindByPredicate(
-		[this](const FStrafeGameModeInfo& Info)
-		{
-			return Info.DisplayName.ToString() == SelectedGameModeName;
-		});
+	const FStrafeGameModeInfo* GameModeInfo = FindSelectedGameModeInfo();
 
 	// If found, populate the map display names from its compatible maps list
 	if (GameModeInfo)
@@ -372,5 +330,92 @@ void US_UI_VM_CreateGame::OnGameModeChanged(FString InSelectedGameModeName)
 		SelectedMapName = MapDisplayNames[0];
 	}
 
+	// Start loading the new selection while the user looks at the rest of the form
+	PrefetchSelection();
+
 	BroadcastDataChanged();
+}
+
+void US_UI_VM_CreateGame::OnMapChanged(FString InSelectedMapName)
+{
+	if (SelectedMapName == InSelectedMapName)
+	{
+		return;
+	}
+
+	SelectedMapName = InSelectedMapName;
+	PrefetchSelection();
+}
+
+const FStrafeGameModeInfo* US_UI_VM_CreateGame::FindSelectedGameModeInfo() const
+{
+	if (!UISettings.IsValid())
+	{
+		return nullptr;
+	}
+
+	return UISettings->AvailableGameModes.FindByPredicate(
+		[this](const FStrafeGameModeInfo& Info)
+		{
+			return Info.DisplayName.ToString() == SelectedGameModeName;
+		});
+}
+
+const TSoftObjectPtr<UWorld>* US_UI_VM_CreateGame::FindSelectedMapAsset(const FStrafeGameModeInfo& GameModeInfo) const
+{
+	return GameModeInfo.CompatibleMaps.FindByPredicate(
+		[this](const TSoftObjectPtr<UWorld>& MapAsset)
+		{
+			// Get the asset name from the soft pointer path
+			return FPaths::GetBaseFilename(MapAsset.ToString()) == SelectedMapName;
+		});
+}
+
+void US_UI_VM_CreateGame::PrefetchSelection()
+{
+	const FStrafeGameModeInfo* GameModeInfo = FindSelectedGameModeInfo();
+	const TSoftObjectPtr<UWorld>* MapAsset = GameModeInfo ? FindSelectedMapAsset(*GameModeInfo) : nullptr;
+
+	Prefetch(GameModeInfo ? GameModeInfo->GameModeClass.ToSoftObjectPath() : FSoftObjectPath(), GameModeClassHandle, GameModeClassPath);
+	Prefetch(MapAsset ? MapAsset->ToSoftObjectPath() : FSoftObjectPath(), MapHandle, MapPath);
+}
+
+void US_UI_VM_CreateGame::Prefetch(const FSoftObjectPath& Path, TSharedPtr<FStreamableHandle>& InOutHandle, FSoftObjectPath& InOutPath)
+{
+	if (InOutHandle.IsValid() && InOutPath == Path && !InOutHandle->WasCanceled())
+	{
+		return;
+	}
+
+	// Swap in the new load before cancelling the old one, so nothing the cancel runs sees the abandoned handle
+	TSharedPtr<FStreamableHandle> PreviousHandle = MoveTemp(InOutHandle);
+	InOutPath = Path;
+	if (!Path.IsNull())
+	{
+		InOutHandle = UAssetManager::Get().GetStreamableManager().RequestAsyncLoad(Path);
+	}
+
+	// Cancelling also releases a finished load, so abandoned maps can be collected
+	if (PreviousHandle.IsValid())
+	{
+		PreviousHandle->CancelHandle();
+	}
+}
+
+void US_UI_VM_CreateGame::ResumeCreateNewSession()
+{
+	// Streamable callbacks run inside CancelHandle and the load completion; resuming from there would re-enter Prefetch
+	if (!ResumeTickerHandle.IsValid())
+	{
+		ResumeTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateUObject(this, &US_UI_VM_CreateGame::TickResumeCreateNewSession), 0.0f
+		);
+	}
+}
+
+bool US_UI_VM_CreateGame::TickResumeCreateNewSession(float DeltaTime)
+{
+	ResumeTickerHandle.Reset();
+	CreateNewSession();
+	return false;
 }
\ No newline at end of file
@@ -3,6 +3,21 @@
 #include "ViewModel/S_UI_VM_Leaderboards.h"
 #include "Engine/World.h"
 
+void US_UI_VM_LeaderboardEntry::ResetForPool()
+{
+    Rank = 0;
+    PlayerName.Reset();
+    MapName.Reset();
+    Time = 0.0f;
+    FormattedTime.Reset();
+}
+
+void US_UI_VM_Leaderboards::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+{
+    Super::AddReferencedObjects(InThis, Collector);
+    CastChecked<US_UI_VM_Leaderboards>(InThis)->EntryPool.AddReferencedObjects(Collector);
+}
+
 void US_UI_VM_Leaderboards::Initialize()
 {
     // Create the leaderboard service
@@ -26,6 +41,16 @@ void US_UI_VM_Leaderboards::SetMapFilter(const FString& NewMapName)
     if (CurrentMapName != NewMapName)
     {
         CurrentMapName = NewMapName;
+
+        // Entries from the previous map must not stay listed while the new map loads
+        for (UObject* Existing : LeaderboardEntries)
+        {
+            if (US_UI_VM_LeaderboardEntry* ExistingEntry = Cast<US_UI_VM_LeaderboardEntry>(Existing))
+            {
+                RetiredEntries.Add(ExistingEntry);
+            }
+        }
+        LeaderboardEntries.Empty();
         RefreshLeaderboard();
     }
 }
@@ -40,21 +65,42 @@ void US_UI_VM_Leaderboards::RefreshLeaderboard()
     // Set loading state
     bIsLoading = true;
     BroadcastDataChanged();
+    ReleaseRetiredEntries();
 
-    // Clear existing entries
-    LeaderboardEntries.Empty();
-
-    // Fetch new data
+    // Fetch new data. The current entries stay listed until the new data arrives.
     LeaderboardService->FetchLeaderboardData(CurrentMapName,
         [this](TArray<FLeaderboardEntry> Entries)
         {
+            // Reuse the entries of players that are still ranked so their list rows survive the refresh
+            TMap<FString, US_UI_VM_LeaderboardEntry*> ExistingEntries;
+            ExistingEntries.Reserve(LeaderboardEntries.Num());
+            for (UObject* Existing : LeaderboardEntries)
+            {
+                if (US_UI_VM_LeaderboardEntry* ExistingEntry = Cast<US_UI_VM_LeaderboardEntry>(Existing))
+                {
+                    ExistingEntries.Add(ExistingEntry->PlayerName, ExistingEntry);
+                }
+            }
+
             // Convert raw entries to view model entries
-            LeaderboardEntries.Empty();
+            LeaderboardEntries.Reset(Entries.Num());
 
             int32 Rank = 1;
             for (const FLeaderboardEntry& Entry : Entries)
             {
-                US_UI_VM_LeaderboardEntry* VMEntry = NewObject<US_UI_VM_LeaderboardEntry>(this);
+                // Each entry is reused at most once, even if a player name repeats
+                US_UI_VM_LeaderboardEntry* VMEntry = nullptr;
+                ExistingEntries.RemoveAndCopyValue(Entry.PlayerName, VMEntry);
+                if (VMEntry && VMEntry->MapName != Entry.MapName)
+                {
+                    RetiredEntries.Add(VMEntry);
+                    VMEntry = nullptr;
+                }
+                if (!VMEntry)
+                {
+                    VMEntry = EntryPool.Acquire(this);
+                }
+
                 VMEntry->Rank = Rank++;
                 VMEntry->PlayerName = Entry.PlayerName;
                 VMEntry->MapName = Entry.MapName;
@@ -64,9 +110,16 @@ void US_UI_VM_Leaderboards::RefreshLeaderboard()
                 LeaderboardEntries.Add(VMEntry);
             }
 
+            // Players no longer ranked
+            for (const TPair<FString, US_UI_VM_LeaderboardEntry*>& Removed : ExistingEntries)
+            {
+                RetiredEntries.Add(Removed.Value);
+            }
+
             // Update loading state
             bIsLoading = false;
             BroadcastDataChanged();
+            ReleaseRetiredEntries();
         });
 }
 
@@ -84,6 +137,18 @@ void US_UI_VM_Leaderboards::PlayReplayForEntry(UObject* EntryObject)
     }
 }
 
+void US_UI_VM_Leaderboards::ReleaseRetiredEntries()
+{
+    for (US_UI_VM_LeaderboardEntry* Entry : RetiredEntries)
+    {
+        EntryPool.Release(Entry);
+    }
+    RetiredEntries.Reset();
+
+    UE_LOG(LogTemp, Verbose, TEXT("Leaderboard entry pool: %d allocated, %d reused, %d free"),
+        EntryPool.GetAllocationCount(), EntryPool.GetReuseCount(), EntryPool.GetNumFree());
+}
+
 FString US_UI_VM_Leaderboards::FormatTime(float TimeInSeconds) const
 {
     int32 Minutes = FMath::FloorToInt(TimeInSeconds / 60.0f);
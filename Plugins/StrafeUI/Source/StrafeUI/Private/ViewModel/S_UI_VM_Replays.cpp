@@ -5,6 +5,21 @@
 #include "Engine/World.h"
 #include "Engine/GameInstance.h"
 
+void US_UI_VM_ReplayEntry::ResetForPool()
+{
+    FileName.Reset();
+    FormattedTimestamp.Reset();
+    FileSizeText.Reset();
+    Timestamp = FDateTime();
+    FileSizeKB = 0;
+}
+
+void US_UI_VM_Replays::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+{
+    Super::AddReferencedObjects(InThis, Collector);
+    CastChecked<US_UI_VM_Replays>(InThis)->EntryPool.AddReferencedObjects(Collector);
+}
+
 void US_UI_VM_Replays::Initialize()
 {
     // Create the replay service
@@ -21,24 +36,37 @@ void US_UI_VM_Replays::RefreshReplays()
         return;
     }
 
-    // Set loading state
+    // Set loading state. The current entries stay listed until the new results arrive.
     bIsLoading = true;
     BroadcastDataChanged();
 
-    // Clear existing entries
-    ReplayEntries.Empty();
-    SelectedReplay = nullptr;
-
     // Find replays
     ReplayService->FindLocalReplays(
         [this](TArray<FReplayInfo> Replays)
         {
+            // Reuse the entries of replays that are still on disk so their list rows survive the refresh
+            TMap<FString, US_UI_VM_ReplayEntry*> ExistingEntries;
+            ExistingEntries.Reserve(ReplayEntries.Num());
+            for (UObject* Existing : ReplayEntries)
+            {
+                if (US_UI_VM_ReplayEntry* ExistingEntry = Cast<US_UI_VM_ReplayEntry>(Existing))
+                {
+                    ExistingEntries.Add(ExistingEntry->FileName, ExistingEntry);
+                }
+            }
+
             // Convert raw entries to view model entries
-            ReplayEntries.Empty();
+            ReplayEntries.Reset(Replays.Num());
 
             for (const FReplayInfo& Info : Replays)
             {
-                US_UI_VM_ReplayEntry* Entry = NewObject<US_UI_VM_ReplayEntry>(this);
+                US_UI_VM_ReplayEntry* Entry = nullptr;
+                ExistingEntries.RemoveAndCopyValue(Info.FileName, Entry);
+                if (!Entry)
+                {
+                    Entry = EntryPool.Acquire(this);
+                }
+
                 Entry->FileName = Info.FileName;
                 Entry->Timestamp = Info.Timestamp;
                 Entry->FileSizeKB = Info.FileSizeKB;
@@ -48,9 +76,24 @@ void US_UI_VM_Replays::RefreshReplays()
                 ReplayEntries.Add(Entry);
             }
 
+            // Keep the selection only if the selected replay still exists
+            if (SelectedReplay && !ReplayEntries.Contains(SelectedReplay))
+            {
+                SelectedReplay = nullptr;
+            }
+
             // Update loading state
             bIsLoading = false;
             BroadcastDataChanged();
+
+            // Entries of deleted replays can be reused now that the view has dropped them
+            for (const TPair<FString, US_UI_VM_ReplayEntry*>& Removed : ExistingEntries)
+            {
+                EntryPool.Release(Removed.Value);
+            }
+
+            UE_LOG(LogTemp, Verbose, TEXT("Replay entry pool: %d allocated, %d reused, %d free"),
+                EntryPool.GetAllocationCount(), EntryPool.GetReuseCount(), EntryPool.GetNumFree());
         });
 }
 
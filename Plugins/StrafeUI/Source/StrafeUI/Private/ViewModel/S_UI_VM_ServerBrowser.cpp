@@ -2,6 +2,8 @@
 
 #include "ViewModel/S_UI_VM_ServerBrowser.h"
 #include "S_UI_Subsystem.h"
+#include "S_UI_OnlineSessionManager.h"
+#include "S_UI_Settings.h"
 #include "OnlineSubsystem.h"
 
 #include "OnlineSessionSettings.h"
@@ -11,6 +13,19 @@
 #include "GameFramework/PlayerController.h"
 #include "Data/S_UI_ScreenTypes.h"
 #include "Online/OnlineSessionNames.h"
+#include "Services/S_ServerListCache.h"
+#include "Services/S_JoinTrace.h"
+#include "Hash/CityHash.h"
+#include "Algo/BinarySearch.h"
+#include "S_UI_AssetManager.h"
+#include "Engine/AssetManager.h"
+#include "Misc/PackageName.h"
+#include "UObject/UObjectGlobals.h"
+#include "Async/Async.h"
+#include "Tasks/Task.h"
+#include "Misc/ScopeExit.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include <atomic>
 
 // Match the custom session settings keys from CreateGame
 #define SETTING_GAMEMODE FName(TEXT("GAMEMODE"))
@@ -22,33 +37,259 @@
 #define SETTING_TIMELIMIT FName(TEXT("TIMELIMIT"))
 #define SETTING_SCORELIMIT FName(TEXT("SCORELIMIT"))
 #define SETTING_RESPAWNTIME FName(TEXT("RESPAWNTIME"))
+// Newline separated player names; only present for hosts that advertise them
+#define SETTING_PLAYERLIST FName(TEXT("PLAYERLIST"))
 // *** FIX: Add a unique tag to filter sessions by, preventing other games on Steam App ID 480 from showing up ***
 #define SETTING_GAMETAG FName(TEXT("GAMETAG"))
 
-US_UI_VM_ServerBrowser::~US_UI_VM_ServerBrowser()
+/**
+ * Search results decoded on worker threads. Each task fills its own slice of Servers and
+ * RowTexts; the game thread reads a slice only after its task has completed.
+ */
+struct F_ServerDecodeJob
 {
-	// Clean up any pending delegates
-	IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get();
-	if (OnlineSubsystem)
+	TArray<F_ServerInfo> Servers;
+	TArray<F_ServerRowText> RowTexts;
+	TArray<UE::Tasks::FTask> ChunkTasks;
+	int32 ChunkSize = 1;
+
+	/** Arena index of the search being decoded */
+	int32 SearchIndex = INDEX_NONE;
+
+	/** Index of the next result to commit on the game thread */
+	int32 NextResult = 0;
+
+	/** Set when the browser no longer wants the results; pending chunks skip their work */
+	std::atomic<bool> bCancelled = false;
+};
+
+uint32 US_UI_VM_ServerListEntry::GetDisplayHash() const
+{
+	uint32 Hash = GetTypeHash(ServerInfo.PlayerCount);
+	Hash = HashCombine(Hash, GetTypeHash(ServerInfo.ServerName.ToString()));
+	Hash = HashCombine(Hash, GetTypeHash(ServerInfo.MaxPlayers));
+	Hash = HashCombine(Hash, GetTypeHash(ServerInfo.Ping));
+	Hash = HashCombine(Hash, GetTypeHash(ServerInfo.bIsPrivate));
+	Hash = HashCombine(Hash, GetTypeHash(ServerInfo.bIsLAN));
+	Hash = HashCombine(Hash, GetTypeHash(ServerInfo.Source));
+	Hash = HashCombine(Hash, GetTypeHash(ServerInfo.GameModeId));
+	Hash = HashCombine(Hash, GetTypeHash(ServerInfo.MapId));
+	return HashCombine(Hash, GetTypeHash(ServerInfo.bIsStale));
+}
+
+void US_UI_VM_ServerListEntry::ResetForPool()
+{
+	ServerInfo = F_ServerInfo();
+	SessionResult = F_SessionResultHandle();
+	Display = F_ServerRowDisplay();
+}
+
+void US_UI_VM_ServerListEntry::UpdateDisplay()
+{
+	Display.PlayerCount = FText::Format(NSLOCTEXT("ServerList", "PlayerCount", "{0}/{1}"),
+		FText::AsNumber(ServerInfo.PlayerCount),
+		FText::AsNumber(ServerInfo.MaxPlayers));
+	Display.CapacityColor = GetCapacityColor(ServerInfo.PlayerCount, ServerInfo.MaxPlayers);
+	Display.FillPercent = ServerInfo.MaxPlayers > 0 ? (float)ServerInfo.PlayerCount / (float)ServerInfo.MaxPlayers : 0.0f;
+
+	if (ServerInfo.bIsStale)
+	{
+		// Cached entries waiting for the live search
+		Display.Opacity = 0.5f;
+	}
+	else if (ServerInfo.PlayerCount >= ServerInfo.MaxPlayers)
+	{
+		// Slightly dim full servers
+		Display.Opacity = 0.7f;
+	}
+	else if (ServerInfo.PlayerCount == 0)
+	{
+		// Slightly dim empty servers
+		Display.Opacity = 0.8f;
+	}
+	else
+	{
+		Display.Opacity = 1.0f;
+	}
+
+	UpdatePingDisplay();
+}
+
+void US_UI_VM_ServerListEntry::UpdatePingDisplay()
+{
+	Display.Ping = FText::AsNumber(ServerInfo.Ping);
+	Display.PingColor = GetPingColor(ServerInfo.Ping);
+}
+
+FLinearColor US_UI_VM_ServerListEntry::GetPingColor(int32 Ping)
+{
+	if (Ping < 50)
+	{
+		// Excellent ping - Green
+		return FLinearColor(0.0f, 1.0f, 0.0f, 1.0f);
+	}
+	else if (Ping < 100)
+	{
+		// Good ping - Yellow-Green
+		return FLinearColor(0.7f, 1.0f, 0.0f, 1.0f);
+	}
+	else if (Ping < 150)
+	{
+		// Moderate ping - Yellow
+		return FLinearColor(1.0f, 1.0f, 0.0f, 1.0f);
+	}
+	else if (Ping < 200)
+	{
+		// Poor ping - Orange
+		return FLinearColor(1.0f, 0.5f, 0.0f, 1.0f);
+	}
+	else
+	{
+		// Very poor ping - Red
+		return FLinearColor(1.0f, 0.0f, 0.0f, 1.0f);
+	}
+}
+
+FLinearColor US_UI_VM_ServerListEntry::GetCapacityColor(int32 CurrentPlayers, int32 MaxPlayers)
+{
+	if (MaxPlayers <= 0)
+	{
+		return FLinearColor::White;
+	}
+
+	float FillPercent = (float)CurrentPlayers / (float)MaxPlayers;
+
+	if (FillPercent >= 1.0f)
+	{
+		// Full server - Red
+		return FLinearColor(1.0f, 0.2f, 0.2f, 1.0f);
+	}
+	else if (FillPercent >= 0.75f)
+	{
+		// Nearly full - Orange
+		return FLinearColor(1.0f, 0.6f, 0.0f, 1.0f);
+	}
+	else if (FillPercent >= 0.5f)
+	{
+		// Half full - Yellow
+		return FLinearColor(1.0f, 1.0f, 0.0f, 1.0f);
+	}
+	else if (FillPercent > 0.0f)
+	{
+		// Has players - Green
+		return FLinearColor(0.0f, 1.0f, 0.0f, 1.0f);
+	}
+	else
+	{
+		// Empty - Gray
+		return FLinearColor(0.5f, 0.5f, 0.5f, 1.0f);
+	}
+}
+
+void US_UI_VM_ServerBrowser::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+{
+	Super::AddReferencedObjects(InThis, Collector);
+	CastChecked<US_UI_VM_ServerBrowser>(InThis)->EntryPool.AddReferencedObjects(Collector);
+}
+
+void US_UI_VM_ServerBrowser::BeginDestroy()
+{
+	// Runs while the outer chain is still alive; cancelling reaches the session manager through it and runs completion delegates
+	StopIngestion();
+	CancelServerSearches();
+
+	if (FilterTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(FilterTickerHandle);
+	}
+
+	if (AutoRefreshTickerHandle.IsValid())
 	{
-		IOnlineSessionPtr SessionInterface = OnlineSubsystem->GetSessionInterface();
-		if (SessionInterface.IsValid())
+		FTSTicker::GetCoreTicker().RemoveTicker(AutoRefreshTickerHandle);
+	}
+
+	// Stop listening for a pending join and drop queued ping queries; pending ones go first so cancelling starts no more
+	PendingPingQueries.Reset();
+	if (US_UI_OnlineSessionManager* SessionManager = GetSessionManager())
+	{
+		SessionManager->CancelOperation(JoinOperationId);
+
+		TArray<int32> PingOperationIds;
+		ActivePingQueries.GenerateValueArray(PingOperationIds);
+		for (const int32 OperationId : PingOperationIds)
 		{
-			SessionInterface->ClearOnFindSessionsCompleteDelegate_Handle(FindSessionsCompleteDelegateHandle);
-			SessionInterface->ClearOnJoinSessionCompleteDelegate_Handle(JoinSessionCompleteDelegateHandle);
+			SessionManager->CancelOperation(OperationId);
 		}
 	}
+
+	ReleaseMapPreload();
+
+	Super::BeginDestroy();
 }
 
 void US_UI_VM_ServerBrowser::RequestServerListRefresh()
 {
 	UE_LOG(LogTemp, Log, TEXT("Refreshing server list..."));
 
-	// Clear existing lists
-	ServerList.Empty();
-	AllFoundServers.Empty();
+	// Drop any searches and results still in flight from the previous refresh
+	StopIngestion();
+	CancelServerSearches();
+	PendingPingQueries.Reset();
+
+	// Clear existing lists. Results of the previous search are released with them.
+	RetireServerEntries();
+	ResultArena.Reset();
+	bIsRevalidating = false;
+	UnconfirmedRows.Empty();
+
+	// The list is empty, so the current filters apply to every row from here on
+	AppliedFilter = MakeFilterState();
+
+	// Show the last successful results while the new search runs
+	LoadCachedServers();
 	BroadcastDataChanged();
+	ReleaseRetiredEntries();
+
+	StartServerSearches(true);
+}
+
+void US_UI_VM_ServerBrowser::RevalidateServerList()
+{
+	// A refresh that is already running brings fresh results anyway
+	if (ActiveSearches.Num() > 0 || DecodeJobs.Num() > 0)
+	{
+		return;
+	}
+
+	// Cached rows cannot be joined, so there is nothing worth keeping
+	if (AllFoundServers.Num() == 0 || bHasCachedRows)
+	{
+		RequestServerListRefresh();
+		return;
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Revalidating %d servers..."), AllFoundServers.Num());
+
+	StopIngestion();
+	CancelServerSearches();
+
+	// Every current row stays listed until a search confirms it or the revalidation ends without it
+	bIsRevalidating = true;
+	UnconfirmedRows.Init(true, AllFoundServers.Num());
+	FirstRevalidationSearch = ResultArena.Num();
+	RevalidationChangeCount = 0;
+	bRebuildServerListPending = false;
+
+	if (!StartServerSearches(false))
+	{
+		// The current rows stay as they are and the next attempt backs off
+		bAnySearchFailed = true;
+		EndRevalidation();
+	}
+}
 
+bool US_UI_VM_ServerBrowser::StartServerSearches(bool bReportErrors)
+{
 	// Get the Online Subsystem
 	IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get();
 	if (!OnlineSubsystem)
@@ -56,7 +297,8 @@ void US_UI_VM_ServerBrowser::RequestServerListRefresh()
 		UE_LOG(LogTemp, Error, TEXT("No online subsystem found"));
 
 		// Show error modal
-		if (UWorld* World = GetWorld())
+		UWorld* World = GetWorld();
+		if (bReportErrors && World)
 		{
 			if (US_UI_Subsystem* UISubsystem = World->GetGameInstance()->GetSubsystem<US_UI_Subsystem>())
 			{
@@ -66,190 +308,1189 @@ void US_UI_VM_ServerBrowser::RequestServerListRefresh()
 				UISubsystem->RequestModal(Payload, FOnModalDismissedSignature());
 			}
 		}
-		return;
-	}
-
-	// Get the Session Interface
-	IOnlineSessionPtr SessionInterface = OnlineSubsystem->GetSessionInterface();
-	if (!SessionInterface.IsValid())
-	{
-		UE_LOG(LogTemp, Error, TEXT("Session interface is invalid"));
-		return;
-	}
-
-	// Create the search object
-	SessionSearch = MakeShareable(new FOnlineSessionSearch());
-	if (!SessionSearch.IsValid())
-	{
-		UE_LOG(LogTemp, Error, TEXT("Failed to create session search object"));
-		return;
+		return false;
 	}
 
-	// Configure the search
-	SessionSearch->bIsLanQuery = bSearchLAN;
-	SessionSearch->MaxSearchResults = 10000;
-	SessionSearch->QuerySettings.Set(SEARCH_PRESENCE, true, EOnlineComparisonOp::Equals);
-
-	// *** FIX: Add a query filter for our unique game tag ***
-	SessionSearch->QuerySettings.Set(SETTING_GAMETAG, FString("StrafeGame"), EOnlineComparisonOp::Equals);
-
-
 	// Get the local player
 	UWorld* World = GetWorld();
 	if (!World)
 	{
 		UE_LOG(LogTemp, Error, TEXT("No world context"));
-		return;
+		return false;
 	}
 
 	APlayerController* PC = World->GetFirstPlayerController();
 	if (!PC || !PC->GetLocalPlayer())
 	{
 		UE_LOG(LogTemp, Error, TEXT("No local player controller"));
-		return;
+		return false;
 	}
 
 	const ULocalPlayer* LocalPlayer = PC->GetLocalPlayer();
 
-	// Bind the completion delegate
-	FindSessionsCompleteDelegateHandle = SessionInterface->AddOnFindSessionsCompleteDelegate_Handle(
-		FOnFindSessionsCompleteDelegate::CreateUObject(this, &US_UI_VM_ServerBrowser::OnFindSessionsComplete)
-	);
+	// Every search of this refresh is sent with the same backend filters
+	SearchQuery = MakeSearchQuery();
 
-	// Start the search
-	if (!SessionInterface->FindSessions(*LocalPlayer->GetPreferredUniqueNetId(), SessionSearch.ToSharedRef()))
+	// Searches run concurrently, so the combined list arrives as fast as the slower of them
+	// A search that fails straight away completes inside the loop; the refresh must not end before the other source is listed
 	{
-		UE_LOG(LogTemp, Error, TEXT("Failed to start session search"));
+		TGuardValue<bool> StartingGuard(bStartingSearches, true);
+		for (const E_ServerSource Source : GetSearchSources())
+		{
+			if (!StartServerSearch(Source, LocalPlayer->GetPreferredUniqueNetId().GetUniqueNetId()))
+			{
+				bAnySearchFailed = true;
+			}
+		}
+	}
 
-		// Clean up the delegate since we won't get a callback
-		SessionInterface->ClearOnFindSessionsCompleteDelegate_Handle(FindSessionsCompleteDelegateHandle);
+	if (ActiveSearches.Num() == 0 && DecodeJobs.Num() == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Failed to start session search"));
 
 		// Show error modal
-		if (US_UI_Subsystem* UISubsystem = World->GetGameInstance()->GetSubsystem<US_UI_Subsystem>())
+		if (bReportErrors)
 		{
-			F_UIModalPayload Payload;
-			Payload.Message = FText::FromString(TEXT("Failed to search for game sessions. Please try again."));
-			Payload.ModalType = E_UIModalType::OK;
-			UISubsystem->RequestModal(Payload, FOnModalDismissedSignature());
+			if (US_UI_Subsystem* UISubsystem = World->GetGameInstance()->GetSubsystem<US_UI_Subsystem>())
+			{
+				F_UIModalPayload Payload;
+				Payload.Message = FText::FromString(TEXT("Failed to search for game sessions. Please try again."));
+				Payload.ModalType = E_UIModalType::OK;
+				UISubsystem->RequestModal(Payload, FOnModalDismissedSignature());
+			}
 		}
+		return false;
 	}
+
+	return true;
 }
 
-void US_UI_VM_ServerBrowser::OnFindSessionsComplete(bool bWasSuccessful)
+FName US_UI_VM_ServerBrowser::GetSessionSubsystemName(E_ServerSource Source)
 {
-	// Clean up the delegate
-	IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get();
-	if (OnlineSubsystem)
+	// LAN games are hosted on the same subsystem by Create Game, so the search sees them
+	return Source == E_ServerSource::LAN ? US_UI_OnlineSessionManager::GetLANSubsystemName() : NAME_None;
+}
+
+IOnlineSessionPtr US_UI_VM_ServerBrowser::GetSessionInterface(E_ServerSource Source)
+{
+	IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get(GetSessionSubsystemName(Source));
+	if (!OnlineSubsystem)
+	{
+		return nullptr;
+	}
+	return OnlineSubsystem->GetSessionInterface();
+}
+
+TArray<E_ServerSource, TInlineAllocator<2>> US_UI_VM_ServerBrowser::GetSearchSources() const
+{
+	TArray<E_ServerSource, TInlineAllocator<2>> Sources;
+
+	if (SearchMode != E_ServerSearchMode::Combined)
+	{
+		Sources.Add(SearchMode == E_ServerSearchMode::LAN ? E_ServerSource::LAN : E_ServerSource::Online);
+		return Sources;
+	}
+
+	// A session interface runs one search at a time, so both sources need their own
+	if (GetSessionInterface(E_ServerSource::LAN) != GetSessionInterface(E_ServerSource::Online))
+	{
+		Sources.Add(E_ServerSource::LAN);
+		Sources.Add(E_ServerSource::Online);
+	}
+	else if (IOnlineSubsystem::Get() && IOnlineSubsystem::Get()->GetSubsystemName() == NULL_SUBSYSTEM)
+	{
+		// The NULL subsystem has no online backend, so LAN is all it can search
+		Sources.Add(E_ServerSource::LAN);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Warning, TEXT("No NULL subsystem available for LAN queries; searching online only"));
+		Sources.Add(E_ServerSource::Online);
+	}
+
+	return Sources;
+}
+
+bool US_UI_VM_ServerBrowser::StartServerSearch(E_ServerSource Source, const FUniqueNetIdPtr& SearchingUserId)
+{
+	US_UI_OnlineSessionManager* SessionManager = GetSessionManager();
+	if (!SessionManager || !GetSessionInterface(Source).IsValid())
+	{
+		UE_LOG(LogTemp, Error, TEXT("Session interface is invalid for %s search"), *UEnum::GetValueAsString(Source));
+		return false;
+	}
+
+	// Create the search object
+	TSharedRef<FOnlineSessionSearch> Search = MakeShareable(new FOnlineSessionSearch());
+
+	// Configure the search
+	Search->bIsLanQuery = Source == E_ServerSource::LAN;
+	Search->MaxSearchResults = 10000;
+	Search->QuerySettings.Set(SEARCH_PRESENCE, true, EOnlineComparisonOp::Equals);
+
+	// *** FIX: Add a query filter for our unique game tag ***
+	Search->QuerySettings.Set(SETTING_GAMETAG, FString("StrafeGame"), EOnlineComparisonOp::Equals);
+
+	// Let the backend drop servers the filters would hide anyway; the local filters still check every row
+	if (SearchQuery.bNonEmptyOnly)
+	{
+		Search->QuerySettings.Set(SEARCH_NONEMPTY_SERVERS_ONLY, true, EOnlineComparisonOp::Equals);
+	}
+	if (SearchQuery.bOpenSlotsOnly)
+	{
+		Search->QuerySettings.Set(SEARCH_MINSLOTSAVAILABLE, 1, EOnlineComparisonOp::GreaterThanEquals);
+	}
+	if (!SearchQuery.GameMode.IsEmpty())
+	{
+		Search->QuerySettings.Set(SETTING_GAMEMODE, SearchQuery.GameMode, EOnlineComparisonOp::Equals);
+	}
+	if (!SearchQuery.MapName.IsEmpty())
+	{
+		Search->QuerySettings.Set(SETTING_MAPNAME, SearchQuery.MapName, EOnlineComparisonOp::Equals);
+	}
+
+	// Queue the search behind any session call already running on the source's subsystem
+	F_SessionOperation Operation;
+	Operation.DebugName = FString::Printf(TEXT("Find %s sessions"), *UEnum::GetValueAsString(Source));
+	Operation.SubsystemName = GetSessionSubsystemName(Source);
+	Operation.UserId = SearchingUserId;
+	Operation.Steps.Add(F_SessionStep::MakeFind(Search));
+	Operation.CoalesceKey = Source == E_ServerSource::LAN ? FName(TEXT("FindLANSessions")) : FName(TEXT("FindOnlineSessions"));
+	Operation.OnComplete.BindUObject(this, &US_UI_VM_ServerBrowser::OnFindSessionsComplete, Source);
+
+	// Listed first, since a search that fails to start completes before SubmitOperation returns
+	ActiveSearches.Add({ Source, Search });
+	const int32 OperationId = SessionManager->SubmitOperation(MoveTemp(Operation));
+	F_ServerSearchRequest* Request = ActiveSearches.FindByPredicate([Source](const F_ServerSearchRequest& Request) { return Request.Source == Source; });
+	if (!Request)
+	{
+		// Already completed, which only happens when the search could not be started
+		UE_LOG(LogTemp, Error, TEXT("Failed to start %s session search"), *UEnum::GetValueAsString(Source));
+		return false;
+	}
+
+	Request->OperationId = OperationId;
+	return true;
+}
+
+void US_UI_VM_ServerBrowser::CancelServerSearches()
+{
+	// Cleared first, so the cancellation reports find nothing to complete
+	TArray<F_ServerSearchRequest> CancelledSearches = MoveTemp(ActiveSearches);
+	ActiveSearches.Reset();
+	bAnySearchFailed = false;
+
+	if (US_UI_OnlineSessionManager* SessionManager = GetSessionManager())
 	{
-		IOnlineSessionPtr SessionInterface = OnlineSubsystem->GetSessionInterface();
-		if (SessionInterface.IsValid())
+		for (const F_ServerSearchRequest& Request : CancelledSearches)
 		{
-			SessionInterface->ClearOnFindSessionsCompleteDelegate_Handle(FindSessionsCompleteDelegateHandle);
+			SessionManager->CancelOperation(Request.OperationId);
 		}
 	}
+}
 
-	// Clear the lists
-	AllFoundServers.Empty();
+void US_UI_VM_ServerBrowser::OnFindSessionsComplete(const F_SessionOperationReport& Report, E_ServerSource Source)
+{
+	const int32 RequestIndex = ActiveSearches.IndexOfByPredicate([Source](const F_ServerSearchRequest& Request) { return Request.Source == Source; });
+	if (RequestIndex == INDEX_NONE)
+	{
+		// The search was cancelled by a newer refresh
+		return;
+	}
 
-	if (bWasSuccessful && SessionSearch.IsValid())
+	const bool bWasSuccessful = Report.Succeeded();
+	const TSharedRef<FOnlineSessionSearch> Search = ActiveSearches[RequestIndex].Search;
+	ActiveSearches.RemoveAt(RequestIndex);
+
+	if (!bWasSuccessful)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("%s session search failed"), *UEnum::GetValueAsString(Source));
+		bAnySearchFailed = true;
+	}
+	else if (Search->SearchResults.Num() > 0)
 	{
-		UE_LOG(LogTemp, Log, TEXT("Session search complete. Found %d sessions"), SessionSearch->SearchResults.Num());
+		UE_LOG(LogTemp, Log, TEXT("%s session search complete. Found %d sessions"), *UEnum::GetValueAsString(Source), Search->SearchResults.Num());
 
-		// Process each found session
-		for (const FOnlineSessionSearchResult& SearchResult : SessionSearch->SearchResults)
-		{
-			US_UI_VM_ServerListEntry* NewEntry = NewObject<US_UI_VM_ServerListEntry>(this);
+		// The arena shares the search object, so results are never copied out of it
+		const int32 SearchIndex = ResultArena.AddSearch(Search);
 
-			// Store the full search result for joining later
-			NewEntry->SessionSearchResult = SearchResult;
+		// Cached rows stay listed until live results replace them
+		const int32 NumResults = Search->SearchResults.Num();
+		TotalResultCount += NumResults;
+		AllFoundServers.Reserve(AllFoundServers.Num() + NumResults);
+		ServerIndexByKey.Reserve(ServerIndexByKey.Num() + NumResults);
+		ServerTable.Reserve(ServerTable.Num() + NumResults);
+		bIsIngestingResults = true;
 
-			// Extract basic info
-			F_ServerInfo& ServerInfo = NewEntry->ServerInfo;
+		// Decode on worker threads; the ticker commits chunks in order as they complete
+		LaunchDecodeJob(Search, SearchIndex, Source);
+		OnIngestionProgress.Broadcast(IngestedResultCount, TotalResultCount);
+
+		if (!IngestionTickerHandle.IsValid())
+		{
+			IngestionTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+				FTickerDelegate::CreateUObject(this, &US_UI_VM_ServerBrowser::TickIngestion)
+			);
+		}
+		return;
+	}
+	else
+	{
+		UE_LOG(LogTemp, Log, TEXT("%s session search returned no results"), *UEnum::GetValueAsString(Source));
+	}
 
-			// Get player counts
-			ServerInfo.PlayerCount = SearchResult.Session.SessionSettings.NumPublicConnections - SearchResult.Session.NumOpenPublicConnections;
-			ServerInfo.MaxPlayers = SearchResult.Session.SessionSettings.NumPublicConnections;
+	CompleteRefreshIfDone();
+}
 
-			// Get ping
-			ServerInfo.Ping = SearchResult.PingInMs;
+void US_UI_VM_ServerBrowser::CompleteRefreshIfDone()
+{
+	// Another search or ingestion still running finishes the refresh; while searches are being started, StartServerSearches does
+	if (ActiveSearches.Num() > 0 || DecodeJobs.Num() > 0 || bStartingSearches)
+	{
+		return;
+	}
 
-			// Get basic settings
-			ServerInfo.bIsPrivate = !SearchResult.Session.SessionSettings.bShouldAdvertise;
-			ServerInfo.bIsLAN = SearchResult.Session.SessionSettings.bIsLANMatch;
+	if (TotalResultCount > 0)
+	{
+		FinishIngestion();
+		return;
+	}
 
-			// Get custom session data
-			FString GameName;
-			if (SearchResult.Session.SessionSettings.Get(SETTING_GAMENAME, GameName))
-			{
-				ServerInfo.ServerName = FText::FromString(GameName);
-			}
-			else
+	if (bIsRevalidating)
+	{
+		// Every listed server went away; an automatic refresh applies that quietly instead of raising a modal
+		if (!bAnySearchFailed)
+		{
+			RevalidationChangeCount += AllFoundServers.Num();
+			RetireServerEntries();
+			ResultArena.Reset();
+		}
+		EndRevalidation();
+	}
+	else
+	{
+		// Show modal if no servers found
+		if (!bAnySearchFailed)
+		{
+			// Nothing is online anymore, so the cached servers are gone too
+			RetireServerEntries();
+
+			if (UWorld* World = GetWorld())
 			{
-				ServerInfo.ServerName = FText::FromString(TEXT("Unknown Server"));
+				if (US_UI_Subsystem* UISubsystem = World->GetGameInstance()->GetSubsystem<US_UI_Subsystem>())
+				{
+					F_UIModalPayload Payload;
+					Payload.Message = FText::FromString(TEXT("No game sessions found. Try creating your own!"));
+					Payload.ModalType = E_UIModalType::OK;
+					UISubsystem->RequestModal(Payload, FOnModalDismissedSignature());
+				}
 			}
+		}
+		ScheduleAutoRefresh(true);
+	}
+
+	// Refresh the displayed list; after a failed search any cached servers stay visible
+	bIsIngestingResults = false;
+	BroadcastDataChanged();
+	ReleaseRetiredEntries();
+
+	RevalidateIfQueryOutdated();
+}
+
+void US_UI_VM_ServerBrowser::EndRevalidation()
+{
+	// Surviving rows now refer to the new searches, unless a failed search left unconfirmed rows in place
+	if (!bAnySearchFailed)
+	{
+		ResultArena.ReleaseSearchesBefore(FirstRevalidationSearch);
+	}
+
+	UE_LOG(LogTemp, Log, TEXT("Revalidation applied %d changes"), RevalidationChangeCount);
+
+	bIsRevalidating = false;
+	UnconfirmedRows.Empty();
+	ScheduleAutoRefresh(bAnySearchFailed || RevalidationChangeCount == 0);
+}
+
+void US_UI_VM_ServerBrowser::RevalidateIfQueryOutdated()
+{
+	if (ActiveSearches.Num() > 0 || DecodeJobs.Num() > 0 || SearchQuery.Includes(MakeSearchQuery()))
+	{
+		return;
+	}
+
+	// Servers the last search filtered out on the backend cannot be brought back locally; fetch them while the current rows stay listed
+	RevalidateServerList();
+}
+
+void US_UI_VM_ServerBrowser::SetAutoRefreshEnabled(bool bEnabled)
+{
+	bAutoRefreshEnabled = bEnabled;
+	ScheduleAutoRefresh(false);
+}
+
+void US_UI_VM_ServerBrowser::ScheduleAutoRefresh(bool bBackOff)
+{
+	const US_UI_Settings* Settings = GetDefault<US_UI_Settings>();
+	const float Interval = Settings->ServerAutoRefreshIntervalSeconds;
+
+	// Quiet or failing backends are polled less and less often; any change brings the interval back
+	AutoRefreshDelay = bBackOff
+		? FMath::Min(FMath::Max(AutoRefreshDelay, Interval) * 2.0f, FMath::Max(Settings->ServerAutoRefreshMaxIntervalSeconds, Interval))
+		: Interval;
+
+	if (AutoRefreshTickerHandle.IsValid())
+	{
+		FTSTicker::GetCoreTicker().RemoveTicker(AutoRefreshTickerHandle);
+		AutoRefreshTickerHandle.Reset();
+	}
+
+	if (bAutoRefreshEnabled && Interval > 0.0f)
+	{
+		AutoRefreshTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateUObject(this, &US_UI_VM_ServerBrowser::TickAutoRefresh), AutoRefreshDelay
+		);
+	}
+}
+
+bool US_UI_VM_ServerBrowser::TickAutoRefresh(float DeltaTime)
+{
+	// Returning false removes the ticker, so just forget the handle
+	AutoRefreshTickerHandle.Reset();
+
+	// A refresh that is already running schedules the next one when it finishes
+	RevalidateServerList();
+
+	// Nothing started, so nothing will finish and reschedule
+	if (ActiveSearches.Num() == 0 && DecodeJobs.Num() == 0 && !AutoRefreshTickerHandle.IsValid())
+	{
+		ScheduleAutoRefresh(true);
+	}
+	return false;
+}
+
+float US_UI_VM_ServerBrowser::GetIngestionProgress() const
+{
+	return TotalResultCount > 0 ? (float)IngestedResultCount / (float)TotalResultCount : 1.0f;
+}
+
+int64 US_UI_VM_ServerBrowser::MakeSessionKey(const FOnlineSessionSearchResult& SearchResult)
+{
+	const FString SessionId = SearchResult.GetSessionIdStr();
+	return (int64)CityHash64(reinterpret_cast<const char*>(*SessionId), SessionId.Len() * sizeof(TCHAR));
+}
+
+US_UI_VM_ServerListEntry* US_UI_VM_ServerBrowser::FindServerEntry(int64 SessionKey) const
+{
+	if (const int32* Index = ServerIndexByKey.Find(SessionKey))
+	{
+		return AllFoundServers[*Index];
+	}
+	return nullptr;
+}
+
+bool US_UI_VM_ServerBrowser::JoinServer(int64 SessionKey)
+{
+	// A manual pick replaces any Quick Join still in progress
+	bIsQuickJoining = false;
+	QuickJoinCandidates.Reset();
+
+	US_UI_VM_ServerListEntry* Entry = FindServerEntry(SessionKey);
+	if (!Entry)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("JoinServer: No server with key %lld"), SessionKey);
+		return false;
+	}
+
+	if (Entry->ServerInfo.bIsStale)
+	{
+		// Cached entries have no session to join until a live search confirms them
+		UE_LOG(LogTemp, Warning, TEXT("JoinServer: Server %lld is still being refreshed"), SessionKey);
+
+		if (UWorld* World = GetWorld())
+		{
+			if (US_UI_Subsystem* UISubsystem = World->GetGameInstance()->GetSubsystem<US_UI_Subsystem>())
+			{
+				F_UIModalPayload Payload;
+				Payload.Message = FText::FromString(TEXT("This server is still being refreshed. Please try again in a moment."));
+				Payload.ModalType = E_UIModalType::OK;
+				UISubsystem->RequestModal(Payload, FOnModalDismissedSignature());
+			}
+		}
+		return false;
+	}
+
+	const FOnlineSessionSearchResult* SearchResult = ResultArena.Resolve(Entry->SessionResult);
+	if (!SearchResult)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("JoinServer: Search result for server %lld is no longer available"), SessionKey);
+		return false;
+	}
+
+	F_JoinTrace::Begin(E_JoinTraceFlow::Join, Entry->ServerInfo.ServerName.ToString());
+	JoinSession(*SearchResult, Entry->ServerInfo.Source);
+	return true;
+}
+
+bool US_UI_VM_ServerBrowser::QuickJoin()
+{
+	F_JoinTrace::Begin(E_JoinTraceFlow::Join, TEXT("Quick Join"));
+	F_JoinTrace::BeginPhase(TEXT("SelectServer"));
+
+	const US_UI_Settings* Settings = GetDefault<US_UI_Settings>();
+
+	F_ServerScoreWeights Weights;
+	Weights.PingWeight = Settings->QuickJoinPingWeight;
+	Weights.FillWeight = Settings->QuickJoinFillWeight;
+	Weights.PreferredGameModeId = ServerTable.GameModeNames->Intern(Settings->QuickJoinPreferredGameMode);
+	Weights.GameModeBonus = Settings->QuickJoinGameModeBonus;
+
+	// Rank the servers that pass the current filters straight from the live table; no new search is needed
+	TArray<int32> BestRows;
+	ServerTable.SelectBestRows(ServerSelection, Weights, Settings->QuickJoinCandidateCount, BestRows);
+
+	QuickJoinCandidates.Reset(BestRows.Num());
+	for (const int32 Row : BestRows)
+	{
+		QuickJoinCandidates.Add(AllFoundServers[Row]->ServerInfo.SessionKey);
+	}
+
+	bIsQuickJoining = true;
+	if (JoinNextQuickJoinCandidate())
+	{
+		return true;
+	}
+	bIsQuickJoining = false;
+	F_JoinTrace::End(false, TEXT("NoServer"));
+
+	UE_LOG(LogTemp, Warning, TEXT("QuickJoin: No joinable server in the filtered list"));
+
+	if (UWorld* World = GetWorld())
+	{
+		if (US_UI_Subsystem* UISubsystem = World->GetGameInstance()->GetSubsystem<US_UI_Subsystem>())
+		{
+			F_UIModalPayload Payload;
+			Payload.Message = FText::FromString(TEXT("No open servers match your filters. Try refreshing or relaxing the filters."));
+			Payload.ModalType = E_UIModalType::OK;
+			UISubsystem->RequestModal(Payload, FOnModalDismissedSignature());
+		}
+	}
+	return false;
+}
+
+bool US_UI_VM_ServerBrowser::JoinNextQuickJoinCandidate()
+{
+	while (QuickJoinCandidates.Num() > 0)
+	{
+		const int64 SessionKey = QuickJoinCandidates[0];
+		QuickJoinCandidates.RemoveAt(0);
+
+		// A refresh may have dropped the server since it was ranked
+		const US_UI_VM_ServerListEntry* Entry = FindServerEntry(SessionKey);
+		const FOnlineSessionSearchResult* SearchResult = Entry ? ResultArena.Resolve(Entry->SessionResult) : nullptr;
+		if (!SearchResult)
+		{
+			continue;
+		}
+
+		UE_LOG(LogTemp, Log, TEXT("QuickJoin: Joining server %lld"), SessionKey);
+		JoinSession(*SearchResult, Entry->ServerInfo.Source);
+		return true;
+	}
+	return false;
+}
+
+void US_UI_VM_ServerBrowser::RefreshServerPings(const TArray<int64>& SessionKeys)
+{
+	// Only the latest request matters; rows that scrolled out of view are not worth measuring
+	PendingPingQueries.Reset();
+	for (const int64 SessionKey : SessionKeys)
+	{
+		if (!ActivePingQueries.Contains(SessionKey))
+		{
+			PendingPingQueries.AddUnique(SessionKey);
+		}
+	}
+
+	StartPingQueries();
+}
+
+void US_UI_VM_ServerBrowser::StartPingQueries()
+{
+	// Queries that complete synchronously land back here; the loop below already fills the freed slot
+	if (PendingPingQueries.Num() == 0 || bStartingPingQueries)
+	{
+		return;
+	}
+	TGuardValue<bool> StartingGuard(bStartingPingQueries, true);
+
+	UWorld* World = GetWorld();
+	APlayerController* PC = World ? World->GetFirstPlayerController() : nullptr;
+	if (!PC || !PC->GetLocalPlayer())
+	{
+		PendingPingQueries.Reset();
+		return;
+	}
+
+	const FUniqueNetIdRepl SearchingUserId = PC->GetLocalPlayer()->GetPreferredUniqueNetId();
+	US_UI_OnlineSessionManager* SessionManager = GetSessionManager();
+	if (!SearchingUserId.IsValid() || !SessionManager)
+	{
+		PendingPingQueries.Reset();
+		return;
+	}
+
+	const int32 MaxConcurrentQueries = GetDefault<US_UI_Settings>()->MaxConcurrentPingQueries;
+
+	while (ActivePingQueries.Num() < MaxConcurrentQueries && PendingPingQueries.Num() > 0)
+	{
+		// Popped before the query is issued, so a synchronous completion never sees it as pending
+		const int64 SessionKey = PendingPingQueries[0];
+		PendingPingQueries.RemoveAt(0, 1, EAllowShrinking::No);
+
+		// Cached entries have no session to query yet
+		const US_UI_VM_ServerListEntry* Entry = FindServerEntry(SessionKey);
+		const FOnlineSessionSearchResult* SearchResult = Entry ? ResultArena.Resolve(Entry->SessionResult) : nullptr;
+		if (!SearchResult || !SearchResult->Session.SessionInfo.IsValid())
+		{
+			continue;
+		}
+
+		// Query through the subsystem that found the server, queued so it never overlaps a search or join on it
+		const FOnlineSession& Session = SearchResult->Session;
+		F_SessionOperation Operation;
+		Operation.DebugName = FString::Printf(TEXT("Ping server %lld"), SessionKey);
+		Operation.SubsystemName = GetSessionSubsystemName(Entry->ServerInfo.Source);
+		Operation.UserId = SearchingUserId.GetUniqueNetId();
+		Operation.Steps.Add(F_SessionStep::MakeFindById(Session.SessionInfo->GetSessionId().AsShared(), Session.OwningUserId));
+		Operation.OnComplete.BindUObject(this, &US_UI_VM_ServerBrowser::OnPingQueryComplete, SessionKey);
+
+		// Register before submitting, since the query may complete before SubmitOperation returns
+		ActivePingQueries.Add(SessionKey, INDEX_NONE);
+		const int32 OperationId = SessionManager->SubmitOperation(MoveTemp(Operation));
+		if (int32* ActiveOperationId = ActivePingQueries.Find(SessionKey))
+		{
+			*ActiveOperationId = OperationId;
+		}
+	}
+}
+
+void US_UI_VM_ServerBrowser::OnPingQueryComplete(const F_SessionOperationReport& Report, int64 SessionKey)
+{
+	ActivePingQueries.Remove(SessionKey);
+
+	if (Report.Succeeded())
+	{
+		UpdateServerPing(SessionKey, Report.FoundSession.PingInMs);
+	}
+	else if (Report.Result != E_SessionOperationResult::Cancelled)
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("Ping query for server %lld %s"), SessionKey, Report.Result == E_SessionOperationResult::TimedOut ? TEXT("timed out") : TEXT("failed"));
+	}
+
+	StartPingQueries();
+}
+
+void US_UI_VM_ServerBrowser::UpdateServerPing(int64 SessionKey, int32 Ping)
+{
+	const int32* Row = ServerIndexByKey.Find(SessionKey);
+	if (!Row)
+	{
+		// The server went away with a refresh while the query was in flight
+		return;
+	}
+
+	US_UI_VM_ServerListEntry* Entry = AllFoundServers[*Row];
+	if (Entry->ServerInfo.bIsStale || Entry->ServerInfo.Ping == Ping)
+	{
+		return;
+	}
+
+	Entry->ServerInfo.Ping = Ping;
+	Entry->UpdatePingDisplay();
+	ServerTable.SetPing(*Row, Ping, SortColumn, bSortDescending);
+
+	// Update the visible copy in place; the row keeps its position until the next filter or sort pass
+	const int32 ListIndex = ServerListRows.Find(*Row);
+	if (ListIndex != INDEX_NONE)
+	{
+		ServerList[ListIndex].Ping = Ping;
+	}
+
+	// The new ping may cross the max ping filter; rows not filtered yet are handled when their batch is
+	if (ServerSelection.IsValidIndex(*Row >> 5))
+	{
+		const bool bWasSelected = F_ServerTable::IsSelected(ServerSelection, *Row);
+		const bool bPasses = PassesFilters(*Row);
+		if (bWasSelected != bPasses)
+		{
+			if (bPasses)
+			{
+				ServerSelection[*Row >> 5] |= 1u << (*Row & 31);
+				InsertFilteredServer(*Row);
+			}
+			else
+			{
+				ServerSelection[*Row >> 5] &= ~(1u << (*Row & 31));
+				if (ListIndex != INDEX_NONE)
+				{
+					ServerList.RemoveAt(ListIndex);
+					ServerListRows.RemoveAt(ListIndex);
+				}
+			}
+
+			BroadcastDataChanged();
+			return;
+		}
+	}
+
+	OnServerInfoUpdated.Broadcast(SessionKey);
+}
+
+void US_UI_VM_ServerBrowser::DecodeSearchResult(const FOnlineSessionSearchResult& SearchResult, F_ServerNameTable& GameModeNames, F_ServerNameTable& MapNames, F_ServerInfo& OutServerInfo)
+{
+	// Extract basic info
+	F_ServerInfo& ServerInfo = OutServerInfo;
+	ServerInfo.SessionKey = MakeSessionKey(SearchResult);
+
+	// Get player counts
+	ServerInfo.PlayerCount = SearchResult.Session.SessionSettings.NumPublicConnections - SearchResult.Session.NumOpenPublicConnections;
+	ServerInfo.MaxPlayers = SearchResult.Session.SessionSettings.NumPublicConnections;
+
+	// Get ping
+	ServerInfo.Ping = SearchResult.PingInMs;
+
+	// Get basic settings
+	ServerInfo.bIsPrivate = !SearchResult.Session.SessionSettings.bShouldAdvertise;
+	ServerInfo.bIsLAN = SearchResult.Session.SessionSettings.bIsLANMatch;
+
+	// Get custom session data
+	FString GameName;
+	if (SearchResult.Session.SessionSettings.Get(SETTING_GAMENAME, GameName))
+	{
+		ServerInfo.ServerName = FText::FromString(GameName);
+	}
+	else
+	{
+		ServerInfo.ServerName = FText::FromString(TEXT("Unknown Server"));
+	}
+
+	// Game mode and map repeat across servers, so they share one interned text each
+	FString GameMode;
+	if (SearchResult.Session.SessionSettings.Get(SETTING_GAMEMODE, GameMode))
+	{
+		ServerInfo.GameModeId = GameModeNames.Intern(GameMode, ServerInfo.GameMode);
+	}
+
+	FString MapName;
+	if (SearchResult.Session.SessionSettings.Get(SETTING_MAPNAME, MapName))
+	{
+		ServerInfo.MapId = MapNames.Intern(MapName, ServerInfo.CurrentMap);
+	}
+}
+
+void US_UI_VM_ServerBrowser::DecodeServerDetails(const FOnlineSessionSearchResult& SearchResult, F_ServerDetails& OutDetails)
+{
+	const FOnlineSessionSettings& Settings = SearchResult.Session.SessionSettings;
+
+	FString Description;
+	if (Settings.Get(SETTING_SERVERDESC, Description))
+	{
+		OutDetails.Description = FText::FromString(Description);
+	}
+
+	Settings.Get(SETTING_FRIENDLYFIRE, OutDetails.bFriendlyFire);
+	Settings.Get(SETTING_SPECTATORS, OutDetails.bAllowSpectators);
+	Settings.Get(SETTING_TIMELIMIT, OutDetails.TimeLimit);
+	Settings.Get(SETTING_SCORELIMIT, OutDetails.ScoreLimit);
+	Settings.Get(SETTING_RESPAWNTIME, OutDetails.RespawnTime);
+
+	FString PlayerList;
+	if (Settings.Get(SETTING_PLAYERLIST, PlayerList))
+	{
+		PlayerList.ParseIntoArrayLines(OutDetails.PlayerNames);
+	}
+}
+
+bool US_UI_VM_ServerBrowser::GetServerDetails(int64 SessionKey, F_ServerDetails& OutDetails)
+{
+	if (const F_ServerDetails* CachedDetails = ServerDetailsByKey.Find(SessionKey))
+	{
+		OutDetails = *CachedDetails;
+		return true;
+	}
+
+	const US_UI_VM_ServerListEntry* Entry = FindServerEntry(SessionKey);
+	const FOnlineSessionSearchResult* SearchResult = Entry ? ResultArena.Resolve(Entry->SessionResult) : nullptr;
+	if (!SearchResult)
+	{
+		return false;
+	}
+
+	F_ServerDetails& Details = ServerDetailsByKey.Add(SessionKey);
+	Details.SessionKey = SessionKey;
+	DecodeServerDetails(*SearchResult, Details);
+	OutDetails = Details;
+	return true;
+}
+
+void US_UI_VM_ServerBrowser::LaunchDecodeJob(const TSharedRef<FOnlineSessionSearch>& Search, int32 SearchIndex, E_ServerSource Source)
+{
+	const int32 NumResults = Search->SearchResults.Num();
+
+	// Tasks hold their own references, so a refresh can drop the job while chunks are still running
+	const TSharedRef<F_ServerDecodeJob> Job = MakeShared<F_ServerDecodeJob>();
+	Job->ChunkSize = FMath::Max(1, GetDefault<US_UI_Settings>()->ServerDecodeChunkSize);
+	Job->SearchIndex = SearchIndex;
+	Job->Servers.SetNum(NumResults);
+	Job->RowTexts.SetNum(NumResults);
+	DecodeJobs.Add(Job);
+
+	const int32 NumChunks = FMath::DivideAndRoundUp(NumResults, Job->ChunkSize);
+	Job->ChunkTasks.Reserve(NumChunks);
+
+	for (int32 Chunk = 0; Chunk < NumChunks; ++Chunk)
+	{
+		const int32 FirstIndex = Chunk * Job->ChunkSize;
+		const int32 EndIndex = FMath::Min(FirstIndex + Job->ChunkSize, NumResults);
+
+		Job->ChunkTasks.Add(UE::Tasks::Launch(UE_SOURCE_LOCATION, [Job, Search, FirstIndex, EndIndex, Source,
+			GameModeNames = ServerTable.GameModeNames, MapNames = ServerTable.MapNames]()
+		{
+			for (int32 Index = FirstIndex; Index < EndIndex && !Job->bCancelled; ++Index)
+			{
+				const FOnlineSessionSearchResult& SearchResult = Search->SearchResults[Index];
+				DecodeSearchResult(SearchResult, *GameModeNames, *MapNames, Job->Servers[Index]);
+				Job->Servers[Index].Source = Source;
+
+				// Descriptions stay out of the summary, but text search still indexes them
+				FString Description;
+				SearchResult.Session.SessionSettings.Get(SETTING_SERVERDESC, Description);
+				Job->RowTexts[Index] = F_ServerRowText::Make(Job->Servers[Index], Description);
+			}
+		}));
+	}
+}
+
+void US_UI_VM_ServerBrowser::CommitDecodedServer(F_ServerInfo&& ServerInfo, F_ServerRowText&& RowText, const F_SessionResultHandle& ResultHandle)
+{
+	US_UI_VM_ServerListEntry* NewEntry = nullptr;
+	if (const int32* ExistingRow = ServerIndexByKey.Find(ServerInfo.SessionKey))
+	{
+		const int32 Row = *ExistingRow;
+		US_UI_VM_ServerListEntry* ExistingEntry = AllFoundServers[Row];
+		if (bIsRevalidating && Row < UnconfirmedRows.Num() && UnconfirmedRows[Row])
+		{
+			UnconfirmedRows[Row] = false;
+
+			// The new result may advertise different rules or players
+			ServerDetailsByKey.Remove(ServerInfo.SessionKey);
+
+			// Numbers change in place; text is indexed, so a renamed server gets a new row
+			if (ServerTable.HasSameText(Row, RowText))
+			{
+				UpdateServerEntry(Row, MoveTemp(ServerInfo), ResultHandle);
+				return;
+			}
+			++RevalidationChangeCount;
+		}
+		else if (!ExistingEntry->ServerInfo.bIsStale)
+		{
+			// Some backends report the same session more than once; keep the first copy
+			return;
+		}
+		else
+		{
+			--StaleServerCount;
+		}
+
+		// Replace the old row, reusing its entry so the list view keeps the same item and selection
+		ServerTable.MarkSuperseded(Row);
+		SupersededRows.Add(Row);
+		NewEntry = ExistingEntry;
+	}
+	else
+	{
+		NewEntry = EntryPool.Acquire(this);
+		if (bIsRevalidating)
+		{
+			++RevalidationChangeCount;
+		}
+	}
+
+	// Keep a handle to the search result for joining later
+	NewEntry->SessionResult = ResultHandle;
+	NewEntry->ServerInfo = MoveTemp(ServerInfo);
+	NewEntry->UpdateDisplay();
+
+	AddServerEntry(NewEntry, MoveTemp(RowText));
+}
+
+void US_UI_VM_ServerBrowser::UpdateServerEntry(int32 Row, F_ServerInfo&& ServerInfo, const F_SessionResultHandle& ResultHandle)
+{
+	US_UI_VM_ServerListEntry* Entry = AllFoundServers[Row];
+	Entry->SessionResult = ResultHandle;
+	Entry->ServerInfo = MoveTemp(ServerInfo);
+
+	if (!ServerTable.UpdateNumeric(Row, Entry->ServerInfo))
+	{
+		return;
+	}
+	++RevalidationChangeCount;
+	Entry->UpdateDisplay();
+
+	// The row may now pass or fail the filters, and a visible row needs its copy and position refreshed
+	const bool bWasSelected = F_ServerTable::IsSelected(ServerSelection, Row);
+	if (bWasSelected != PassesFilters(Row))
+	{
+		ServerSelection[Row >> 5] ^= 1u << (Row & 31);
+		bRebuildServerListPending = true;
+	}
+	else if (bWasSelected)
+	{
+		bRebuildServerListPending = true;
+	}
+}
+
+void US_UI_VM_ServerBrowser::AddServerEntry(US_UI_VM_ServerListEntry* Entry)
+{
+	AddServerEntry(Entry, F_ServerRowText::Make(Entry->ServerInfo));
+}
+
+void US_UI_VM_ServerBrowser::AddServerEntry(US_UI_VM_ServerListEntry* Entry, F_ServerRowText&& RowText)
+{
+	ServerIndexByKey.Add(Entry->ServerInfo.SessionKey, AllFoundServers.Add(Entry));
+	ServerTable.AddRow(Entry->ServerInfo, MoveTemp(RowText));
+}
+
+void US_UI_VM_ServerBrowser::LoadCachedServers()
+{
+	if (!GetDefault<US_UI_Settings>()->bCacheServerList)
+	{
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+
+	TArray<F_ServerInfo> CachedServers;
+	if (!F_ServerListCache::Load(CachedServers) || CachedServers.Num() == 0)
+	{
+		return;
+	}
+
+	AllFoundServers.Reserve(CachedServers.Num());
+	ServerIndexByKey.Reserve(CachedServers.Num());
+	ServerTable.Reserve(CachedServers.Num());
+
+	for (F_ServerInfo& ServerInfo : CachedServers)
+	{
+		if (ServerIndexByKey.Contains(ServerInfo.SessionKey))
+		{
+			continue;
+		}
+
+		// The cache stores plain strings; share the interned texts like live results do
+		ServerInfo.GameModeId = ServerTable.GameModeNames->Intern(ServerInfo.GameMode.ToString(), ServerInfo.GameMode);
+		ServerInfo.MapId = ServerTable.MapNames->Intern(ServerInfo.CurrentMap.ToString(), ServerInfo.CurrentMap);
+
+		US_UI_VM_ServerListEntry* Entry = EntryPool.Acquire(this);
+		Entry->ServerInfo = MoveTemp(ServerInfo);
+		Entry->UpdateDisplay();
+		AddServerEntry(Entry);
+	}
+
+	StaleServerCount = AllFoundServers.Num();
+	bHasCachedRows = true;
+	AppendFilteredServers(0);
+
+	UE_LOG(LogTemp, Log, TEXT("Loaded %d cached servers in %.3f ms"), StaleServerCount, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void US_UI_VM_ServerBrowser::RetireServerEntries()
+{
+	RetiredEntries.Reserve(RetiredEntries.Num() + AllFoundServers.Num());
+	for (int32 Row = 0; Row < AllFoundServers.Num(); ++Row)
+	{
+		// Replaced cache rows share their entry with a live row, so skip them to retire each entry once
+		if ((ServerTable.Flags[Row] & (int32)E_ServerRowFlags::Superseded) == 0)
+		{
+			RetiredEntries.Add(AllFoundServers[Row]);
+		}
+	}
+
+	ClearServerList();
+	AllFoundServers.Empty();
+	ServerIndexByKey.Empty();
+	ServerTable.Reset();
+	ServerSelection.Reset();
+	SupersededRows.Reset();
+	ServerDetailsByKey.Reset();
+	StaleServerCount = 0;
+	bHasCachedRows = false;
+}
+
+void US_UI_VM_ServerBrowser::ReleaseRetiredEntries()
+{
+	for (US_UI_VM_ServerListEntry* Entry : RetiredEntries)
+	{
+		EntryPool.Release(Entry);
+	}
+	RetiredEntries.Reset();
+
+	UE_LOG(LogTemp, Verbose, TEXT("Server entry pool: %d allocated, %d reused, %d free"),
+		EntryPool.GetAllocationCount(), EntryPool.GetReuseCount(), EntryPool.GetNumFree());
+}
+
+void US_UI_VM_ServerBrowser::SaveCachedServers() const
+{
+	if (!GetDefault<US_UI_Settings>()->bCacheServerList)
+	{
+		return;
+	}
+
+	TArray<F_ServerInfo> Servers;
+	Servers.Reserve(AllFoundServers.Num());
+	for (const US_UI_VM_ServerListEntry* Entry : AllFoundServers)
+	{
+		Servers.Add(Entry->ServerInfo);
+	}
+
+	// Serializing and writing tens of thousands of rows does not belong on the game thread
+	F_ServerListCache::SaveAsync(MoveTemp(Servers));
+}
+
+int32 US_UI_VM_ServerBrowser::RemoveUnconfirmedRows()
+{
+	const int32 CachedRowFlags = (int32)(E_ServerRowFlags::Stale | E_ServerRowFlags::Superseded);
+
+	// A failed search may be the one that would have confirmed a revalidated row, so those stay
+	const bool bDropUnconfirmed = bIsRevalidating && !bAnySearchFailed;
+
+	TArray<int32> LiveRows;
+	LiveRows.Reserve(AllFoundServers.Num());
+	int32 NumRemoved = 0;
+	for (int32 Row = 0; Row < AllFoundServers.Num(); ++Row)
+	{
+		const int32 RowFlags = ServerTable.Flags[Row];
+		const bool bUnconfirmed = bDropUnconfirmed && Row < UnconfirmedRows.Num() && UnconfirmedRows[Row];
+		if ((RowFlags & CachedRowFlags) == 0 && !bUnconfirmed)
+		{
+			LiveRows.Add(Row);
+		}
+		else if ((RowFlags & (int32)E_ServerRowFlags::Superseded) == 0)
+		{
+			// Unconfirmed entry; replaced rows share their entry with a live row
+			RetiredEntries.Add(AllFoundServers[Row]);
+			++NumRemoved;
+		}
+	}
+
+	StaleServerCount = 0;
+	bHasCachedRows = false;
+
+	// Keep the table as it is when every row survived
+	if (LiveRows.Num() == AllFoundServers.Num())
+	{
+		return 0;
+	}
+
+	// Descriptions are only kept lowercased in the table, so carry the text columns over
+	TArray<TObjectPtr<US_UI_VM_ServerListEntry>> LiveServers;
+	TArray<F_ServerRowText> LiveRowTexts;
+	LiveServers.Reserve(LiveRows.Num());
+	LiveRowTexts.Reserve(LiveRows.Num());
+	for (const int32 Row : LiveRows)
+	{
+		LiveServers.Add(AllFoundServers[Row]);
+		LiveRowTexts.Add(ServerTable.GetRowText(Row));
+	}
+
+	AllFoundServers.Reset();
+	ServerIndexByKey.Reset();
+	ServerTable.Reset();
+	ServerSelection.Reset();
+
+	for (int32 Index = 0; Index < LiveServers.Num(); ++Index)
+	{
+		AddServerEntry(LiveServers[Index], MoveTemp(LiveRowTexts[Index]));
+	}
+
+	ClearServerList();
+	AppendFilteredServers(0);
+
+	return NumRemoved;
+}
+
+int32 US_UI_VM_ServerBrowser::IngestBatch(double BudgetSeconds)
+{
+	const int32 FirstNewIndex = AllFoundServers.Num();
+	const int32 FirstIngestedCount = IngestedResultCount;
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Searches are committed in the order they completed, and each one in result order
+	bool bBudgetSpent = false;
+	while (DecodeJobs.Num() > 0 && !bBudgetSpent)
+	{
+		F_ServerDecodeJob& Job = *DecodeJobs[0];
+		const int32 NumResults = Job.Servers.Num();
+
+		// Stop at the first chunk that is still decoding
+		int32 ReadyEnd = 0;
+		while (Job.NextResult < NumResults)
+		{
+			if (Job.NextResult >= ReadyEnd)
+			{
+				const int32 Chunk = Job.NextResult / Job.ChunkSize;
+				if (!Job.ChunkTasks[Chunk].IsCompleted())
+				{
+					break;
+				}
+				ReadyEnd = FMath::Min((Chunk + 1) * Job.ChunkSize, NumResults);
+			}
+
+			CommitDecodedServer(MoveTemp(Job.Servers[Job.NextResult]), MoveTemp(Job.RowTexts[Job.NextResult]),
+				ResultArena.MakeHandle(Job.SearchIndex, Job.NextResult));
+			++Job.NextResult;
+			++IngestedResultCount;
+
+			if (FPlatformTime::Seconds() - StartTime >= BudgetSeconds)
+			{
+				bBudgetSpent = true;
+				break;
+			}
+		}
+
+		if (Job.NextResult < NumResults)
+		{
+			break;
+		}
+		DecodeJobs.RemoveAt(0);
+	}
+
+	// Hide the cached rows that live results replaced during this batch
+	if (SupersededRows.Num() > 0)
+	{
+		for (const int32 Row : SupersededRows)
+		{
+			ServerSelection[Row >> 5] &= ~(1u << (Row & 31));
+		}
+		SupersededRows.Reset();
+		CompactServerList();
+	}
+
+	// Only the new rows need to be filtered; everything before them is already in ServerList
+	AppendFilteredServers(FirstNewIndex);
+
+	// Revalidated rows changed in place; one rebuild covers every one of them
+	if (bRebuildServerListPending)
+	{
+		bRebuildServerListPending = false;
+		RebuildServerList();
+	}
 
-			FString GameMode;
-			if (SearchResult.Session.SessionSettings.Get(SETTING_GAMEMODE, GameMode))
-			{
-				ServerInfo.GameMode = FText::FromString(GameMode);
-			}
+	return IngestedResultCount - FirstIngestedCount;
+}
 
-			FString MapName;
-			if (SearchResult.Session.SessionSettings.Get(SETTING_MAPNAME, MapName))
-			{
-				ServerInfo.CurrentMap = MapName;
-			}
+bool US_UI_VM_ServerBrowser::TickIngestion(float DeltaTime)
+{
+	const US_UI_Settings* Settings = GetDefault<US_UI_Settings>();
+	const int32 NumCommitted = IngestBatch(Settings->ServerIngestionFrameBudgetMicroseconds / 1000000.0);
 
-			FString Description;
-			if (SearchResult.Session.SessionSettings.Get(SETTING_SERVERDESC, Description))
-			{
-				ServerInfo.Description = FText::FromString(Description);
-			}
+	if (DecodeJobs.Num() == 0)
+	{
+		// Returning false removes the ticker, so just forget the handle
+		IngestionTickerHandle.Reset();
 
-			AllFoundServers.Add(NewEntry);
+		if (ActiveSearches.Num() > 0)
+		{
+			// Show what is committed while the remaining search runs; it restarts the ticker when it completes
+			BroadcastDataChanged();
+			OnIngestionProgress.Broadcast(IngestedResultCount, TotalResultCount);
+		}
+		else
+		{
+			FinishIngestion();
 		}
+		return false;
+	}
 
-		// Apply filters to show results
-		UpdateFilteredServerList();
+	// Nothing to show while the next chunk is still decoding
+	if (NumCommitted > 0)
+	{
+		BroadcastDataChanged();
+		OnIngestionProgress.Broadcast(IngestedResultCount, TotalResultCount);
+	}
+	return true;
+}
+
+void US_UI_VM_ServerBrowser::FinishIngestion()
+{
+	UE_LOG(LogTemp, Log, TEXT("Finished ingesting %d sessions"), IngestedResultCount);
+
+	// Cached and revalidated servers the searches did not confirm are gone
+	if (bHasCachedRows || bIsRevalidating)
+	{
+		RevalidationChangeCount += RemoveUnconfirmedRows();
+	}
+
+	if (bIsRevalidating)
+	{
+		EndRevalidation();
 	}
 	else
 	{
-		UE_LOG(LogTemp, Warning, TEXT("Session search failed or returned no results"));
+		ScheduleAutoRefresh(bAnySearchFailed);
+	}
 
-		// Clear the displayed list
-		ServerList.Empty();
-		BroadcastDataChanged();
+	SaveCachedServers();
 
-		// Show modal if no servers found
-		if (bWasSuccessful && SessionSearch.IsValid() && SessionSearch->SearchResults.Num() == 0)
-		{
-			if (UWorld* World = GetWorld())
-			{
-				if (US_UI_Subsystem* UISubsystem = World->GetGameInstance()->GetSubsystem<US_UI_Subsystem>())
-				{
-					F_UIModalPayload Payload;
-					Payload.Message = FText::FromString(TEXT("No game sessions found. Try creating your own!"));
-					Payload.ModalType = E_UIModalType::OK;
-					UISubsystem->RequestModal(Payload, FOnModalDismissedSignature());
-				}
-			}
-		}
-	}
+	bIsIngestingResults = false;
+	BroadcastDataChanged();
+	ReleaseRetiredEntries();
+	OnIngestionProgress.Broadcast(IngestedResultCount, TotalResultCount);
+
+	// Filters widened while the searches ran; their results are incomplete but still worth showing
+	RevalidateIfQueryOutdated();
 }
 
-void US_UI_VM_ServerBrowser::JoinSession(const FOnlineSessionSearchResult& SessionSearchResult)
+void US_UI_VM_ServerBrowser::StopIngestion()
 {
-	// Get the Online Subsystem
-	IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get();
-	if (!OnlineSubsystem)
+	if (IngestionTickerHandle.IsValid())
 	{
-		UE_LOG(LogTemp, Error, TEXT("No online subsystem found"));
-		return;
+		FTSTicker::GetCoreTicker().RemoveTicker(IngestionTickerHandle);
+		IngestionTickerHandle.Reset();
 	}
 
-	// Get the Session Interface
-	IOnlineSessionPtr SessionInterface = OnlineSubsystem->GetSessionInterface();
-	if (!SessionInterface.IsValid())
+	// Chunks still decoding skip the rest of their work; they keep their job alive until they finish
+	for (const TSharedPtr<F_ServerDecodeJob>& Job : DecodeJobs)
+	{
+		Job->bCancelled = true;
+	}
+	DecodeJobs.Reset();
+
+	bIsIngestingResults = false;
+	IngestedResultCount = 0;
+	TotalResultCount = 0;
+}
+
+void US_UI_VM_ServerBrowser::JoinSession(const FOnlineSessionSearchResult& SessionSearchResult, E_ServerSource Source)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(US_UI_VM_ServerBrowser::JoinSession);
+	F_JoinTrace::BeginPhase(TEXT("SessionQueue"));
+
+	// Every early return below ends the attempt; only a submitted join keeps the trace open
+	bool bJoinSubmitted = false;
+	ON_SCOPE_EXIT
+	{
+		if (!bJoinSubmitted)
+		{
+			F_JoinTrace::End(false, TEXT("JoinSessionFailed"));
+		}
+	};
+
+	// Joins are queued on the subsystem that found the session
+	US_UI_OnlineSessionManager* SessionManager = GetSessionManager();
+	if (!SessionManager || !GetSessionInterface(Source).IsValid())
 	{
 		UE_LOG(LogTemp, Error, TEXT("Session interface is invalid"));
 		return;
@@ -272,47 +1513,68 @@ void US_UI_VM_ServerBrowser::JoinSession(const FOnlineSessionSearchResult& Sessi
 
 	const ULocalPlayer* LocalPlayer = PC->GetLocalPlayer();
 
-	// Bind the completion delegate
-	JoinSessionCompleteDelegateHandle = SessionInterface->AddOnJoinSessionCompleteDelegate_Handle(
-		FOnJoinSessionCompleteDelegate::CreateUObject(this, &US_UI_VM_ServerBrowser::OnJoinSessionComplete)
-	);
-
-	// Attempt to join the session
-	if (!SessionInterface->JoinSession(*LocalPlayer->GetPreferredUniqueNetId(), NAME_GameSession, SessionSearchResult))
+	// Load the destination map while the join handshake runs so travel finds it in memory
+	FString MapName;
+	if (GetDefault<US_UI_Settings>()->bPreloadMapOnJoin && SessionSearchResult.Session.SessionSettings.Get(SETTING_MAPNAME, MapName))
 	{
-		UE_LOG(LogTemp, Error, TEXT("Failed to join session"));
-
-		// Clean up the delegate since we won't get a callback
-		SessionInterface->ClearOnJoinSessionCompleteDelegate_Handle(JoinSessionCompleteDelegateHandle);
-
-		// Show error modal
-		if (US_UI_Subsystem* UISubsystem = World->GetGameInstance()->GetSubsystem<US_UI_Subsystem>())
-		{
-			F_UIModalPayload Payload;
-			Payload.Message = FText::FromString(TEXT("Failed to join the selected game session."));
-			Payload.ModalType = E_UIModalType::OK;
-			UISubsystem->RequestModal(Payload, FOnModalDismissedSignature());
-		}
+		StartMapPreload(MapName);
+	}
+	else
+	{
+		ReleaseMapPreload();
 	}
+
+	// Attempt to join the session; a join that cannot start is reported through OnJoinSessionComplete
+	F_SessionOperation Operation;
+	Operation.DebugName = TEXT("Join session");
+	Operation.SubsystemName = GetSessionSubsystemName(Source);
+	Operation.UserId = LocalPlayer->GetPreferredUniqueNetId().GetUniqueNetId();
+	Operation.Steps.Add(F_SessionStep::MakeJoin(SessionSearchResult));
+	Operation.CoalesceKey = TEXT("JoinSession");
+	Operation.bTraceSteps = true;
+	Operation.OnComplete.BindUObject(this, &US_UI_VM_ServerBrowser::OnJoinSessionComplete, Source);
+
+	bJoinSubmitted = true;
+	JoinOperationId = SessionManager->SubmitOperation(MoveTemp(Operation));
 }
 
-void US_UI_VM_ServerBrowser::OnJoinSessionComplete(FName SessionName, EOnJoinSessionCompleteResult::Type Result)
+void US_UI_VM_ServerBrowser::OnJoinSessionComplete(const F_SessionOperationReport& Report, E_ServerSource Source)
 {
-	// Get the session interface
-	IOnlineSubsystem* OnlineSubsystem = IOnlineSubsystem::Get();
-	if (!OnlineSubsystem)
+	TRACE_CPUPROFILER_EVENT_SCOPE(US_UI_VM_ServerBrowser::OnJoinSessionComplete);
+
+	// A newer join replaced this one, or the browser went away
+	if (Report.Result == E_SessionOperationResult::Cancelled || Report.Result == E_SessionOperationResult::Superseded)
 	{
 		return;
 	}
+	if (Report.OperationId == JoinOperationId)
+	{
+		JoinOperationId = INDEX_NONE;
+	}
 
-	IOnlineSessionPtr SessionInterface = OnlineSubsystem->GetSessionInterface();
+	// Get the session interface the join went through
+	IOnlineSessionPtr SessionInterface = GetSessionInterface(Source);
 	if (!SessionInterface.IsValid())
 	{
+		F_JoinTrace::End(false, TEXT("NoSessionInterface"));
+		ReleaseMapPreload();
 		return;
 	}
 
-	// Clean up the delegate
-	SessionInterface->ClearOnJoinSessionCompleteDelegate_Handle(JoinSessionCompleteDelegateHandle);
+	const FName SessionName = Report.SessionName;
+	const EOnJoinSessionCompleteResult::Type Result = Report.Succeeded() ? EOnJoinSessionCompleteResult::Success : Report.JoinResult;
+
+	// Quick Join moves on when the server filled up or went away since the search
+	if (bIsQuickJoining && (Result == EOnJoinSessionCompleteResult::SessionIsFull || Result == EOnJoinSessionCompleteResult::SessionDoesNotExist))
+	{
+		UE_LOG(LogTemp, Log, TEXT("Quick Join candidate unavailable (%d), trying the next one"), (int32)Result);
+		if (JoinNextQuickJoinCandidate())
+		{
+			return;
+		}
+	}
+	bIsQuickJoining = false;
+	QuickJoinCandidates.Reset();
 
 	// Check if join was successful
 	if (Result == EOnJoinSessionCompleteResult::Success)
@@ -320,6 +1582,7 @@ void US_UI_VM_ServerBrowser::OnJoinSessionComplete(FName SessionName, EOnJoinSes
 		UE_LOG(LogTemp, Log, TEXT("Successfully joined session"));
 
 		// Get the connect string
+		F_JoinTrace::BeginPhase(TEXT("ResolveConnectString"));
 		FString ConnectString;
 		if (SessionInterface->GetResolvedConnectString(SessionName, ConnectString))
 		{
@@ -328,17 +1591,27 @@ void US_UI_VM_ServerBrowser::OnJoinSessionComplete(FName SessionName, EOnJoinSes
 			// Travel to the server
 			if (APlayerController* PC = GetWorld()->GetFirstPlayerController())
 			{
+				KeepMapPreloadForTravel();
+				F_JoinTrace::BeginTravel();
 				PC->ClientTravel(ConnectString, ETravelType::TRAVEL_Absolute);
 			}
+			else
+			{
+				F_JoinTrace::End(false, TEXT("NoPlayerController"));
+			}
 		}
 		else
 		{
 			UE_LOG(LogTemp, Error, TEXT("Failed to get connection string"));
+			F_JoinTrace::End(false, TEXT("NoConnectString"));
+			ReleaseMapPreload();
 		}
 	}
 	else
 	{
 		UE_LOG(LogTemp, Error, TEXT("Failed to join session. Result: %d"), (int32)Result);
+		F_JoinTrace::End(false, FString::Printf(TEXT("JoinResult %d"), (int32)Result));
+		ReleaseMapPreload();
 
 		// Show error modal
 		FString ErrorMessage;
@@ -371,75 +1644,410 @@ void US_UI_VM_ServerBrowser::OnJoinSessionComplete(FName SessionName, EOnJoinSes
 	}
 }
 
+void US_UI_VM_ServerBrowser::StartMapPreload(const FString& MapName)
+{
+	const FString PackageName = ResolveMapPackageName(MapName);
+	if (PackageName.IsEmpty())
+	{
+		UE_LOG(LogTemp, Verbose, TEXT("No map package found for '%s'; travel will load it"), *MapName);
+		ReleaseMapPreload();
+		return;
+	}
+
+	// Quick Join candidates often share a map; keep the load that is already running
+	if (MapPreloadHandle.IsValid() && PackageName == MapPreloadPackageName)
+	{
+		return;
+	}
+	ReleaseMapPreload();
+
+	// The map may still be loaded from an earlier visit
+	if (FindPackage(nullptr, *PackageName))
+	{
+		return;
+	}
+
+	const FSoftObjectPath MapPath(FString::Printf(TEXT("%s.%s"), *PackageName, *FPackageName::GetShortName(PackageName)));
+	MapPreloadHandle = UAssetManager::Get().GetStreamableManager().RequestAsyncLoad(MapPath, FStreamableDelegate(), FStreamableManager::AsyncLoadHighPriority);
+	MapPreloadPackageName = PackageName;
+
+	UE_LOG(LogTemp, Log, TEXT("Preloading map %s while joining"), *PackageName);
+}
+
+void US_UI_VM_ServerBrowser::ReleaseMapPreload()
+{
+	if (MapPreloadHandle.IsValid())
+	{
+		MapPreloadHandle->CancelHandle();
+		MapPreloadHandle.Reset();
+	}
+	MapPreloadPackageName.Reset();
+}
+
+void US_UI_VM_ServerBrowser::KeepMapPreloadForTravel()
+{
+	// Travel collects the old world, and this view model with it, before the new map loads
+	US_UI_AssetManager::KeepLoadedUntilNextMap(MoveTemp(MapPreloadHandle));
+	MapPreloadHandle.Reset();
+	MapPreloadPackageName.Reset();
+}
+
+FString US_UI_VM_ServerBrowser::ResolveMapPackageName(const FString& MapName)
+{
+	if (MapName.IsEmpty())
+	{
+		return FString();
+	}
+
+	// Hosts advertise the short map name of one of the configured maps
+	for (const FStrafeGameModeInfo& GameModeInfo : GetDefault<US_UI_Settings>()->AvailableGameModes)
+	{
+		for (const TSoftObjectPtr<UWorld>& MapAsset : GameModeInfo.CompatibleMaps)
+		{
+			if (!MapAsset.IsNull() && FPaths::GetBaseFilename(MapAsset.ToString()).Equals(MapName, ESearchCase::IgnoreCase))
+			{
+				return MapAsset.ToSoftObjectPath().GetLongPackageName();
+			}
+		}
+	}
+
+	// Anything else is only trusted when it names a package that exists
+	FString PackageName;
+	if (FPackageName::IsValidLongPackageName(MapName) && FPackageName::DoesPackageExist(MapName))
+	{
+		PackageName = MapName;
+	}
+	return PackageName;
+}
+
 void US_UI_VM_ServerBrowser::ApplyFilters()
 {
+	// Coalesce every filter edit made this frame into a single evaluation
+	if (!FilterTickerHandle.IsValid())
+	{
+		FilterTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+			FTickerDelegate::CreateUObject(this, &US_UI_VM_ServerBrowser::TickFilters)
+		);
+	}
+}
+
+bool US_UI_VM_ServerBrowser::TickFilters(float DeltaTime)
+{
+	// Returning false removes the ticker, so just forget the handle
+	FilterTickerHandle.Reset();
 	UpdateFilteredServerList();
+	return false;
 }
 
 void US_UI_VM_ServerBrowser::UpdateFilteredServerList()
 {
-	ServerList.Empty();
+	// Widened past the last search's query: the missing servers are fetched in the background, the rest is filtered now
+	RevalidateIfQueryOutdated();
+
+	const F_ServerFilterState NewFilter = MakeFilterState();
+	const E_ServerFilterChange Change = F_ServerFilterState::Compare(AppliedFilter, NewFilter);
+	AppliedFilter = NewFilter;
+
+	const double StartTime = FPlatformTime::Seconds();
 
-	// Apply filters to the full list
-	for (const TObjectPtr<US_UI_VM_ServerListEntry>& Entry : AllFoundServers)
+	switch (Change)
 	{
-		if (PassesFilters(Entry))
-		{
-			ServerList.Add(Entry->ServerInfo);
-		}
+	case E_ServerFilterChange::None:
+		return;
+
+	case E_ServerFilterChange::Narrowed:
+		NarrowFilteredServers();
+		break;
+
+	case E_ServerFilterChange::Widened:
+		WidenFilteredServers();
+		break;
+
+	default:
+		ClearServerList();
+		AppendFilteredServers(0);
+		break;
 	}
 
+	UE_LOG(LogTemp, Verbose, TEXT("Filter change %d applied in %.3f ms"), (int32)Change, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+
 	// Notify UI of changes
 	BroadcastDataChanged();
 }
 
-bool US_UI_VM_ServerBrowser::PassesFilters(const TObjectPtr<US_UI_VM_ServerListEntry>& Entry) const
+void US_UI_VM_ServerBrowser::AppendFilteredServers(int32 FirstIndex)
 {
-	if (!Entry)
+	const double StartTime = FPlatformTime::Seconds();
+
+	// Numeric and flag predicates for every new row in one pass over the packed columns
+	ServerTable.FilterNumeric(AppliedFilter.Numeric, FirstIndex, ServerSelection);
+
+	// Long enough name queries only need to verify rows the trigram index reports as candidates
+	if (AppliedFilter.LowerServerName.Len() >= F_TrigramIndex::MinQueryLength)
 	{
-		return false;
+		RestrictToNameCandidates(FirstIndex);
 	}
 
-	const F_ServerInfo& ServerInfo = Entry->ServerInfo;
+	// Text predicates only for rows that survived, against pre-lowercased columns
+	const bool bHasTextFilters = !AppliedFilter.LowerServerName.IsEmpty() || AppliedFilter.GameModeId != INDEX_NONE || AppliedFilter.MapId != INDEX_NONE;
+	const bool bIsSorted = SortColumn != E_ServerSortColumn::None;
 
-	// Filter by server name
-	if (!FilterServerName.IsEmpty())
+	F_ServerTable::ForEachSelected(ServerSelection, FirstIndex, [this, bHasTextFilters, bIsSorted](int32 Row)
 	{
-		if (!ServerInfo.ServerName.ToString().Contains(FilterServerName, ESearchCase::IgnoreCase))
+		if (bHasTextFilters && !PassesTextFilters(Row))
+		{
+			ServerSelection[Row >> 5] &= ~(1u << (Row & 31));
+			return;
+		}
+
+		if (!bIsSorted)
 		{
-			return false;
+			ServerList.Add(AllFoundServers[Row]->ServerInfo);
+			ServerListRows.Add(Row);
 		}
+	});
+
+	// New rows can land anywhere in a sorted list
+	if (bIsSorted)
+	{
+		RebuildServerList();
 	}
 
-	// Filter by game mode
-	if (!FilterGameMode.IsEmpty())
+	UE_LOG(LogTemp, Verbose, TEXT("Filtered %d servers in %.3f ms"), ServerTable.Num() - FirstIndex, (FPlatformTime::Seconds() - StartTime) * 1000.0);
+}
+
+void US_UI_VM_ServerBrowser::NarrowFilteredServers()
+{
+	// Only visible rows can change, so re-check just those and compact ServerList in place
+	for (const int32 Row : ServerListRows)
 	{
-		if (!ServerInfo.GameMode.ToString().Contains(FilterGameMode, ESearchCase::IgnoreCase))
+		if (!PassesFilters(Row))
 		{
-			return false;
+			ServerSelection[Row >> 5] &= ~(1u << (Row & 31));
 		}
 	}
 
-	// Filter by ping
-	if (ServerInfo.Ping > FilterMaxPing)
+	CompactServerList();
+}
+
+void US_UI_VM_ServerBrowser::WidenFilteredServers()
+{
+	int32 NumAdded = 0;
+	F_ServerTable::ForEachRejected(ServerSelection, ServerTable.Num(), [this, &NumAdded](int32 Row)
 	{
-		return false;
+		if (PassesFilters(Row))
+		{
+			ServerSelection[Row >> 5] |= 1u << (Row & 31);
+			++NumAdded;
+		}
+	});
+
+	// Newly accepted rows are interleaved with the old ones
+	if (NumAdded > 0)
+	{
+		RebuildServerList();
 	}
+}
 
-	// Filter full servers
-	if (bFilterHideFullServers && ServerInfo.PlayerCount >= ServerInfo.MaxPlayers)
+void US_UI_VM_ServerBrowser::RebuildServerList()
+{
+	ClearServerList();
+
+	auto AddRow = [this](int32 Row)
 	{
-		return false;
+		ServerList.Add(AllFoundServers[Row]->ServerInfo);
+		ServerListRows.Add(Row);
+	};
+
+	if (SortColumn == E_ServerSortColumn::None)
+	{
+		F_ServerTable::ForEachSelected(ServerSelection, 0, AddRow);
+		return;
+	}
+
+	// Walk the cached permutation and keep the rows that pass the filters
+	for (const int32 Row : ServerTable.GetSortPermutation(SortColumn, bSortDescending))
+	{
+		if (F_ServerTable::IsSelected(ServerSelection, Row))
+		{
+			AddRow(Row);
+		}
+	}
+}
+
+void US_UI_VM_ServerBrowser::InsertFilteredServer(int32 Row)
+{
+	int32 Index = ServerListRows.Num();
+	if (SortColumn == E_ServerSortColumn::None)
+	{
+		// Unsorted rows are listed in insertion order
+		Index = Algo::LowerBound(ServerListRows, Row);
+	}
+	else
+	{
+		// Place the row before the first listed row that follows it in the active order
+		const TArray<int32>& Permutation = ServerTable.GetSortPermutation(SortColumn, bSortDescending);
+		const int32 SortIndex = Permutation.Find(Row);
+		for (int32 NextIndex = SortIndex + 1; NextIndex < Permutation.Num(); ++NextIndex)
+		{
+			if (F_ServerTable::IsSelected(ServerSelection, Permutation[NextIndex]))
+			{
+				const int32 ListIndex = ServerListRows.Find(Permutation[NextIndex]);
+				Index = ListIndex != INDEX_NONE ? ListIndex : Index;
+				break;
+			}
+		}
+	}
+
+	ServerList.Insert(AllFoundServers[Row]->ServerInfo, Index);
+	ServerListRows.Insert(Row, Index);
+}
+
+void US_UI_VM_ServerBrowser::ClearServerList()
+{
+	ServerList.Reset();
+	ServerListRows.Reset();
+}
+
+void US_UI_VM_ServerBrowser::CompactServerList()
+{
+	int32 WriteIndex = 0;
+	for (int32 ReadIndex = 0; ReadIndex < ServerListRows.Num(); ++ReadIndex)
+	{
+		const int32 Row = ServerListRows[ReadIndex];
+		if (!F_ServerTable::IsSelected(ServerSelection, Row))
+		{
+			continue;
+		}
+
+		if (WriteIndex != ReadIndex)
+		{
+			ServerList[WriteIndex] = MoveTemp(ServerList[ReadIndex]);
+			ServerListRows[WriteIndex] = Row;
+		}
+		++WriteIndex;
+	}
+
+	ServerList.SetNum(WriteIndex);
+	ServerListRows.SetNum(WriteIndex);
+}
+
+void US_UI_VM_ServerBrowser::SetSort(E_ServerSortColumn Column, bool bDescending)
+{
+	if (Column == SortColumn && bDescending == bSortDescending)
+	{
+		return;
+	}
+
+	SortColumn = Column;
+	bSortDescending = bDescending;
+
+	RebuildServerList();
+	BroadcastDataChanged();
+}
+
+void US_UI_VM_ServerBrowser::RestrictToNameCandidates(int32 FirstIndex)
+{
+	const FString& LowerServerName = AppliedFilter.LowerServerName;
+
+	TArray<int32> Candidates;
+	if (!ServerTable.NameIndex.FindCandidates(LowerServerName, FirstIndex, Candidates))
+	{
+		return;
+	}
+
+	TArray<uint32> CandidateMask;
+	CandidateMask.SetNumZeroed(ServerSelection.Num());
+	for (const int32 Row : Candidates)
+	{
+		CandidateMask[Row >> 5] |= 1u << (Row & 31);
+	}
+
+	if (AppliedFilter.bSearchDescriptions)
+	{
+		ServerTable.DescriptionIndex.FindCandidates(LowerServerName, FirstIndex, Candidates);
+		for (const int32 Row : Candidates)
+		{
+			CandidateMask[Row >> 5] |= 1u << (Row & 31);
+		}
+	}
+
+	// Rows before FirstIndex keep their bits
+	const int32 FirstWord = FirstIndex >> 5;
+	for (int32 Word = FirstWord; Word < ServerSelection.Num(); ++Word)
+	{
+		const uint32 KeepMask = Word == FirstWord ? (1u << (FirstIndex & 31)) - 1 : 0u;
+		ServerSelection[Word] &= CandidateMask[Word] | KeepMask;
+	}
+}
+
+F_ServerFilterState US_UI_VM_ServerBrowser::MakeFilterState() const
+{
+	F_ServerFilterState Filter;
+	Filter.Numeric.MaxPing = FilterMaxPing;
+
+	// Replaced cache rows are never shown
+	Filter.Numeric.RejectFlags = E_ServerRowFlags::Superseded;
+
+	if (bFilterHideFullServers)
+	{
+		Filter.Numeric.RejectFlags |= E_ServerRowFlags::Full;
+	}
+	if (bFilterHideEmptyServers)
+	{
+		Filter.Numeric.RejectFlags |= E_ServerRowFlags::Empty;
+	}
+	if (bFilterHidePrivateServers)
+	{
+		Filter.Numeric.RejectFlags |= E_ServerRowFlags::Private;
 	}
 
-	// Filter empty servers
-	if (bFilterHideEmptyServers && ServerInfo.PlayerCount == 0)
+	Filter.LowerServerName = FilterServerName.ToLower();
+	// Interning a value no server has yet is harmless, and keeps the filter valid for servers that arrive later
+	Filter.GameModeId = ServerTable.GameModeNames->Intern(FilterGameMode);
+	Filter.MapId = ServerTable.MapNames->Intern(FilterMapName);
+	Filter.bSearchDescriptions = bFilterSearchDescriptions;
+
+	return Filter;
+}
+
+F_ServerSearchQuery US_UI_VM_ServerBrowser::MakeSearchQuery() const
+{
+	F_ServerSearchQuery Query;
+	Query.bNonEmptyOnly = bFilterHideEmptyServers;
+	Query.bOpenSlotsOnly = bFilterHideFullServers;
+
+	// The game mode filter comes from a fixed list, so an exact match is what the user picked
+	Query.GameMode = FilterGameMode;
+	Query.MapName = FilterMapName;
+
+	// Name, ping and privacy are only known locally
+	return Query;
+}
+
+bool US_UI_VM_ServerBrowser::PassesFilters(int32 Row) const
+{
+	return ServerTable.PassesNumeric(AppliedFilter.Numeric, Row) && PassesTextFilters(Row);
+}
+
+bool US_UI_VM_ServerBrowser::PassesTextFilters(int32 Row) const
+{
+	const FString& LowerServerName = AppliedFilter.LowerServerName;
+
+	// Filter by server name, optionally falling back to the description
+	if (!LowerServerName.IsEmpty()
+		&& !ServerTable.LowerNames[Row].Contains(LowerServerName, ESearchCase::CaseSensitive)
+		&& !(AppliedFilter.bSearchDescriptions && ServerTable.LowerDescriptions[Row].Contains(LowerServerName, ESearchCase::CaseSensitive)))
 	{
 		return false;
 	}
 
-	// Filter private servers
-	if (bFilterHidePrivateServers && ServerInfo.bIsPrivate)
+	// Filter by game mode and map; backends that ignore the pushed query still get the exact match here
+	if (AppliedFilter.GameModeId != INDEX_NONE && ServerTable.GameModeIds[Row] != AppliedFilter.GameModeId)
+	{
+		return false;
+	}
+	if (AppliedFilter.MapId != INDEX_NONE && ServerTable.MapIds[Row] != AppliedFilter.MapId)
 	{
 		return false;
 	}
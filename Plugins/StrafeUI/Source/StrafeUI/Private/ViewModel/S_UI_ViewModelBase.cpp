@@ -1,6 +1,9 @@
 // Plugins/StrafeUI/Source/StrafeUI/Private/ViewModel/S_UI_ViewModelBase.cpp
 
 #include "ViewModel/S_UI_ViewModelBase.h"
+#include "S_UI_Subsystem.h"
+#include "Engine/World.h"
+#include "Engine/GameInstance.h"
 
 void US_UI_ViewModelBase::BroadcastDataChanged()
 {
@@ -10,3 +13,12 @@ void US_UI_ViewModelBase::BroadcastDataChanged()
 	}
 }
 
+
+
+US_UI_OnlineSessionManager* US_UI_ViewModelBase::GetSessionManager() const
+{
+	UWorld* World = GetWorld();
+	UGameInstance* GameInstance = World ? World->GetGameInstance() : nullptr;
+	US_UI_Subsystem* UISubsystem = GameInstance ? GameInstance->GetSubsystem<US_UI_Subsystem>() : nullptr;
+	return UISubsystem ? UISubsystem->GetSessionManager() : nullptr;
+}
\ No newline at end of file
@@ -40,6 +40,13 @@ public:
      */
     TSubclassOf<UCommonActivatableWidget> GetScreenWidgetClass(E_UIScreenId ScreenId) const;
 
+    /**
+     * Keeps the assets of a streamable handle loaded until the next map has finished loading, then releases them.
+     * Lets a destination map preloaded before travel survive the objects that started the load being torn down.
+     * @param Handle The handle to keep. Ignored if null.
+     */
+    static void KeepLoadedUntilNextMap(TSharedPtr<FStreamableHandle> Handle);
+
     /** Delegate broadcast when asset loading is complete. */
     FOnAssetsLoaded OnAssetsLoaded;
 
@@ -6,6 +6,7 @@
 #include "UObject/Object.h"
 #include "OnlineSessionSettings.h"
 #include "Interfaces/OnlineSessionInterface.h"
+#include "Containers/Ticker.h"
 #include "S_UI_OnlineSessionManager.generated.h"
 
 /**
@@ -13,9 +14,143 @@
  */
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnSessionStateChanged, bool, bIsInSession);
 
+/**
+ * A single call into the session interface.
+ */
+enum class E_SessionStepType : uint8
+{
+    Find,
+    /** Looks up a single session by ID, e.g. to re-measure its ping */
+    FindById,
+    Join,
+    Create,
+    Start,
+    Update,
+    End,
+    /** Destroys the session if it exists; succeeds immediately otherwise */
+    Destroy
+};
+
+/**
+ * How a session operation ended.
+ */
+enum class E_SessionOperationResult : uint8
+{
+    Succeeded,
+    Failed,
+    TimedOut,
+    /** Cancelled by CancelOperation or Shutdown */
+    Cancelled,
+    /** Replaced by a newer operation with the same coalescing key before it ran */
+    Superseded
+};
+
+/**
+ * One step of a session operation and the data its call needs.
+ */
+struct STRAFEUI_API F_SessionStep
+{
+    E_SessionStepType Type = E_SessionStepType::Find;
+
+    /** Settings to create or update the session with */
+    TSharedPtr<FOnlineSessionSettings> Settings;
+
+    /** Search to fill; its results are read by the submitter once the step completes */
+    TSharedPtr<FOnlineSessionSearch> Search;
+
+    /** Session to join */
+    FOnlineSessionSearchResult SearchResult;
+
+    /** Session to look up, and the user to look it up through; the searching user if unset */
+    FUniqueNetIdPtr SessionId;
+    FUniqueNetIdPtr FriendId;
+
+    /** Seconds before the step is abandoned. 0 uses the SessionOperationTimeoutSeconds setting. */
+    float TimeoutSeconds = 0.0f;
+
+    static F_SessionStep MakeFind(const TSharedRef<FOnlineSessionSearch>& Search);
+    static F_SessionStep MakeFindById(const FUniqueNetIdRef& SessionId, const FUniqueNetIdPtr& FriendId);
+    static F_SessionStep MakeJoin(const FOnlineSessionSearchResult& SearchResult);
+    static F_SessionStep MakeCreate(const TSharedRef<FOnlineSessionSettings>& Settings);
+    static F_SessionStep MakeUpdate(const TSharedRef<FOnlineSessionSettings>& Settings);
+    static F_SessionStep Make(E_SessionStepType Type);
+};
+
+/**
+ * Latency of one completed step.
+ */
+struct F_SessionStepReport
+{
+    E_SessionStepType Type = E_SessionStepType::Find;
+    bool bSucceeded = false;
+    double Seconds = 0.0;
+};
+
+/**
+ * What happened to a session operation, handed to its completion delegate.
+ */
+struct F_SessionOperationReport
+{
+    int32 OperationId = INDEX_NONE;
+    E_SessionOperationResult Result = E_SessionOperationResult::Failed;
+    FName SessionName;
+
+    /** Seconds the operation waited behind others in its queue */
+    double QueuedSeconds = 0.0;
+
+    /** Seconds from the first step starting to the operation ending */
+    double RunSeconds = 0.0;
+
+    /** Steps that ran, in order */
+    TArray<F_SessionStepReport> Steps;
+
+    /** Result of the join step, if the operation had one */
+    EOnJoinSessionCompleteResult::Type JoinResult = EOnJoinSessionCompleteResult::UnknownError;
+
+    /** Session found by the find-by-ID step, if the operation had one */
+    FOnlineSessionSearchResult FoundSession;
+
+    bool Succeeded() const { return Result == E_SessionOperationResult::Succeeded; }
+};
+
+DECLARE_DELEGATE_OneParam(FOnSessionOperationComplete, const F_SessionOperationReport& /*Report*/);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnSessionOperationFinished, const F_SessionOperationReport& /*Report*/);
+
+/**
+ * A sequence of session steps submitted as one unit. Steps run back to back and the first failure ends the operation.
+ */
+struct STRAFEUI_API F_SessionOperation
+{
+    /** Name used in logs */
+    FString DebugName;
+
+    /** Online subsystem to run against; NAME_None for the default one. Each subsystem has its own queue. */
+    FName SubsystemName;
+
+    FName SessionName = NAME_GameSession;
+
+    /** User the steps run for; the first local user if unset */
+    FUniqueNetIdPtr UserId;
+
+    TArray<F_SessionStep> Steps;
+
+    /** A queued operation with the same key is replaced by this one. NAME_None never coalesces. */
+    FName CoalesceKey;
+
+    /** Whether steps are recorded as phases of the current join trace */
+    bool bTraceSteps = false;
+
+    /** Called once when the operation ends, however it ends */
+    FOnSessionOperationComplete OnComplete;
+};
+
 /**
  * Centralized manager for online session operations
  * Handles session lifecycle and provides helper methods for common operations
+ *
+ * All session state transitions go through a queue per online subsystem, so overlapping requests such as a refresh
+ * during a join never race on the session interface. Operations run one at a time, each step is timed out and
+ * reports its latency, and operations can be cancelled or coalesced while they wait.
  */
 UCLASS()
 class STRAFEUI_API US_UI_OnlineSessionManager : public UObject
@@ -37,6 +172,12 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Online Session")
     FName GetCurrentSessionName() const { return CurrentSessionName; }
 
+    /** Gets the online subsystem the current session was joined or created on; NAME_None for the default one */
+    FName GetCurrentSessionSubsystemName() const { return CurrentSessionSubsystemName; }
+
+    /** Gets the online subsystem LAN games are searched, joined and hosted on; the NULL subsystem when the default one is an online backend */
+    static FName GetLANSubsystemName();
+
     /** Destroy the current session if one exists */
     UFUNCTION(BlueprintCallable, Category = "Online Session")
     void DestroyCurrentSession();
@@ -49,39 +190,172 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Online Session")
     void RegisterSession(const FString& ServerName, const FString& MapName, int32 MaxPlayers);
 
-    /** Update session settings while in a session */
+    /**
+     * Update session settings while in a session.
+     * Changes are merged and sent at most once per SessionUpdateIntervalSeconds; values the session already has are skipped.
+     * A change of the map name is sent straight away.
+     */
     UFUNCTION(BlueprintCallable, Category = "Online Session")
     void UpdateSessionSettings(const TMap<FName, FString>& NewSettings);
 
+    /** Sends the merged setting changes now instead of waiting for the update interval */
+    UFUNCTION(BlueprintCallable, Category = "Online Session")
+    void FlushSessionSettings();
+
     /** Get a reference to the online session interface */
     IOnlineSessionPtr GetSessionInterface() const;
 
+    /** Gets the session interface of an online subsystem; NAME_None for the default one */
+    IOnlineSessionPtr GetSessionInterface(FName SubsystemName) const;
+
+    /**
+     * Queues an operation behind the others of its subsystem.
+     * @param Operation The operation to run.
+     * @return Id for CancelOperation, or INDEX_NONE if the subsystem has no session interface. OnComplete has run in that case.
+     */
+    int32 SubmitOperation(F_SessionOperation&& Operation);
+
+    /**
+     * Cancels a queued or running operation. Its OnComplete runs with Cancelled straight away.
+     * A step already sent to the backend still holds the queue until it completes or times out.
+     * @param OperationId Id returned by SubmitOperation. Unknown and finished ids are ignored.
+     */
+    void CancelOperation(int32 OperationId);
+
+    /** Whether an operation is queued or running */
+    bool IsOperationPending(int32 OperationId) const;
+
     /** Event fired when session state changes */
     UPROPERTY(BlueprintAssignable, Category = "Online Session")
     FOnSessionStateChanged OnSessionStateChanged;
 
+    /** Broadcast after every operation ends, with its latency report */
+    FOnSessionOperationFinished OnOperationFinished;
+
 private:
+    /** An operation in a queue */
+    struct F_PendingOperation
+    {
+        int32 Id = INDEX_NONE;
+        F_SessionOperation Operation;
+        F_SessionOperationReport Report;
+        double SubmitSeconds = 0.0;
+        double FirstStepSeconds = 0.0;
+        int32 NextStep = 0;
+
+        /** Set once OnComplete has run, e.g. when cancelled while its step was with the backend */
+        bool bReported = false;
+    };
+
+    /** The queue of one online subsystem. The first operation is the one running. */
+    struct F_OperationQueue
+    {
+        FName SubsystemName;
+        IOnlineSessionPtr SessionInterface;
+        TArray<F_PendingOperation> Operations;
+
+        /** Completion delegate of the running step */
+        FDelegateHandle StepDelegateHandle;
+        double StepStartSeconds = 0.0;
+        float StepTimeoutSeconds = 0.0f;
+
+        /** Bumped per step so a late failure return is not mistaken for the current step's */
+        uint32 StepSerial = 0;
+        bool bStepRunning = false;
+    };
+
+    /** Gets or creates the queue of a subsystem. Null if the subsystem has no session interface. */
+    F_OperationQueue* FindOrAddQueue(FName SubsystemName);
+
+    /** Finds the queue holding an operation */
+    F_OperationQueue* FindQueueOfOperation(int32 OperationId, int32& OutIndex);
+
+    /** Starts the next step of the front operation if nothing is running */
+    void RunQueue(F_OperationQueue& Queue);
+
+    /** Binds the completion delegate of the front operation's next step and issues its call */
+    void StartStep(F_OperationQueue& Queue);
+
+    /** Removes the running step's completion delegate */
+    void ClearStepDelegate(F_OperationQueue& Queue);
+
+    /** Removes the running step's completion delegate and, for searches, stops the search */
+    void AbortStep(F_OperationQueue& Queue);
+
+    /** Handles a completion callback of the running step of a queue */
+    void CompleteStep(FName SubsystemName, bool bSucceeded, EOnJoinSessionCompleteResult::Type JoinResult = EOnJoinSessionCompleteResult::UnknownError);
+
+    /** Records the running step's result and moves on to the next step or operation */
+    void EndStep(F_OperationQueue& Queue, bool bSucceeded, E_SessionOperationResult FailureResult);
+
+    /** Removes an operation from its queue and reports it unless it already was */
+    void FinishOperation(F_OperationQueue& Queue, int32 Index, E_SessionOperationResult Result);
+
+    /** Logs an operation's latency and runs its completion delegate */
+    void ReportOperation(F_PendingOperation& Pending, E_SessionOperationResult Result);
+
+    /** Fails steps that ran past their timeout */
+    bool TickTimeouts(float DeltaTime);
+
+    /** Flushes the merged setting changes once the update interval has passed. Always returns false so the ticker fires once. */
+    bool TickSettingsFlush(float DeltaTime);
+
+    /** Flushes the pending setting changes now if the update interval has passed and bAllowImmediate is set, else arms the flush ticker */
+    void ScheduleSettingsFlush(bool bAllowImmediate);
+
+    /** Value of a setting as last sent to or accepted by the backend; false if it was never changed here */
+    bool GetAdvertisedSetting(FName Key, FString& OutValue) const;
+
+    /** Forgets all setting changes, so a new session does not compare against the last one */
+    void ResetSettingChanges();
+
+    /** Flushes setting changes made during travel, so browsers see the new map without waiting out the interval */
+    void OnPostLoadMap(class UWorld* World);
+
     /** Callbacks for session operations */
-    void OnDestroySessionComplete(FName SessionName, bool bWasSuccessful);
-    void OnEndSessionComplete(FName SessionName, bool bWasSuccessful);
-    void OnRegisterSessionComplete(FName SessionName, bool bWasSuccessful);
-    void OnUpdateSessionComplete(FName SessionName, bool bWasSuccessful);
+    void OnFindSessionsComplete(bool bWasSuccessful, FName SubsystemName);
+    void OnFindSessionByIdComplete(int32 LocalUserNum, bool bWasSuccessful, const FOnlineSessionSearchResult& SearchResult, FName SubsystemName, uint32 StepSerial);
+    void OnJoinSessionComplete(FName SessionName, EOnJoinSessionCompleteResult::Type Result, FName SubsystemName);
+    void OnStepComplete(FName SessionName, bool bWasSuccessful, FName SubsystemName);
 
-    /** Helper to clean up all session delegates */
-    void ClearAllDelegates();
+    /** Bookkeeping for the convenience operations above */
+    void OnDestroySessionComplete(const F_SessionOperationReport& Report);
+    void OnRegisterSessionComplete(const F_SessionOperationReport& Report);
+    void OnUpdateSessionComplete(const F_SessionOperationReport& Report, TMap<FName, FString> FlushedChanges);
 
     /** The name of the current session */
     FName CurrentSessionName;
 
-    /** Delegate handles for cleanup */
-    FDelegateHandle DestroySessionCompleteDelegateHandle;
-    FDelegateHandle EndSessionCompleteDelegateHandle;
-    FDelegateHandle RegisterSessionCompleteDelegateHandle;
-    FDelegateHandle UpdateSessionCompleteDelegateHandle;
+    /** Online subsystem holding the current session */
+    FName CurrentSessionSubsystemName;
+
+    /** Queues by online subsystem name */
+    TMap<FName, TUniquePtr<F_OperationQueue>> Queues;
+
+    /** Id of the next submitted operation */
+    int32 NextOperationId = 0;
+
+    /** Ticker checking step timeouts while steps are running */
+    FTSTicker::FDelegateHandle TimeoutTickerHandle;
+
+    /** Setting changes not sent to the backend yet */
+    TMap<FName, FString> PendingSettingChanges;
+
+    /** Setting changes sent to the backend and not accepted yet; a failed update puts them back into PendingSettingChanges */
+    TMap<FName, FString> InFlightSettingChanges;
+
+    /** Values the backend has accepted for every setting changed here, seeded with the value it had before the first change */
+    TMap<FName, FString> AcknowledgedSettings;
+
+    /** Time of the last settings update sent to the backend */
+    double LastSettingsFlushSeconds = 0.0;
+
+    /** Ticker flushing PendingSettingChanges once the update interval has passed */
+    FTSTicker::FDelegateHandle SettingsFlushTickerHandle;
+
+    /** Handle of the PostLoadMapWithWorld binding */
+    FDelegateHandle PostLoadMapHandle;
 
     /** Cached session interface */
     IOnlineSessionPtr CachedSessionInterface;
-
-    /** Flag to track if we're currently destroying a session */
-    bool bIsDestroyingSession = false;
 };
\ No newline at end of file
@@ -85,6 +85,70 @@ public:
     TArray<FStrafeGameModeInfo> AvailableGameModes;
     //~ End Create Game Screen Settings
 
+    //~ Begin Server Browser Settings
+    /** Number of search results decoded per worker task. The first chunk is committed as soon as it is ready. */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Server Browser", meta = (ClampMin = "1"))
+    int32 ServerDecodeChunkSize = 256;
+
+    /** Maximum game-thread time, in microseconds, spent committing decoded search results per frame. */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Server Browser", meta = (ClampMin = "100"))
+    int32 ServerIngestionFrameBudgetMicroseconds = 2000;
+
+    /** Whether the last successful search is saved to disk and shown as stale entries while the next search runs. */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Server Browser")
+    bool bCacheServerList = true;
+
+    /** Seconds between ping refreshes of the servers visible in the Find Game list. 0 disables the refresh. */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Server Browser", meta = (ClampMin = "0.0"))
+    float ServerPingRefreshIntervalSeconds = 10.0f;
+
+    /** Maximum number of ping queries in flight at once. */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Server Browser", meta = (ClampMin = "1"))
+    int32 MaxConcurrentPingQueries = 4;
+
+    /** Seconds between background revalidations of the server list while the Find Game screen is open. 0 disables auto-refresh. */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Server Browser", meta = (ClampMin = "0.0"))
+    float ServerAutoRefreshIntervalSeconds = 30.0f;
+
+    /** Longest auto-refresh interval. The interval doubles up to this after a refresh that fails or changes nothing. */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Server Browser", meta = (ClampMin = "0.0"))
+    float ServerAutoRefreshMaxIntervalSeconds = 240.0f;
+
+    /** Number of best-ranked servers Quick Join tries, in order, before giving up. */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Server Browser", meta = (ClampMin = "1"))
+    int32 QuickJoinCandidateCount = 5;
+
+    /** Quick Join score lost per millisecond of ping. */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Server Browser", meta = (ClampMin = "0.0"))
+    float QuickJoinPingWeight = 1.0f;
+
+    /** Quick Join score of a nearly full server relative to an empty one, scaled by how full the server is. */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Server Browser", meta = (ClampMin = "0.0"))
+    float QuickJoinFillWeight = 100.0f;
+
+    /** Game mode Quick Join prefers. Empty for no preference. */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Server Browser")
+    FString QuickJoinPreferredGameMode;
+
+    /** Quick Join score added for servers running the preferred game mode. */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Server Browser", meta = (ClampMin = "0.0"))
+    float QuickJoinGameModeBonus = 50.0f;
+
+    /** Whether joining a server starts loading its map while the session join is still in flight. */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Server Browser")
+    bool bPreloadMapOnJoin = true;
+    //~ End Server Browser Settings
+
+    //~ Begin Online Session Settings
+    /** Seconds a single session call (find, join, create...) may take before it is abandoned and the next queued operation runs. */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Online Session", meta = (ClampMin = "1.0"))
+    float SessionOperationTimeoutSeconds = 30.0f;
+
+    /** Minimum seconds between session setting updates sent to the backend. Changes made in between are merged into the next one. */
+    UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Online Session", meta = (ClampMin = "0.0"))
+    float SessionUpdateIntervalSeconds = 5.0f;
+    //~ End Online Session Settings
+
     //~ Begin Settings Tab Classes
     /** The widget class for the Audio settings tab. */
     UPROPERTY(Config, EditAnywhere, BlueprintReadOnly, Category = "Settings Tabs")
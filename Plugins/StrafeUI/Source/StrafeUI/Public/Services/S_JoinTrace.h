@@ -0,0 +1,104 @@
+// Plugins/StrafeUI/Source/StrafeUI/Public/Services/S_JoinTrace.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Which flow a join trace measures.
+ */
+enum class E_JoinTraceFlow : uint8
+{
+    Join,
+    CreateGame
+};
+
+/**
+ * One timed phase of a join trace. Offsets are relative to the start of the trace.
+ */
+struct F_JoinTracePhase
+{
+    /** Static phase name; also the Unreal Insights region name */
+    const TCHAR* Name = nullptr;
+
+    double StartSeconds = 0.0;
+    double DurationSeconds = 0.0;
+};
+
+/**
+ * Timings of one join or create-game attempt, from the click to the first tick of the destination world.
+ */
+struct F_JoinTraceRecord
+{
+    E_JoinTraceFlow Flow = E_JoinTraceFlow::Join;
+
+    /** Server or map the attempt went to */
+    FString Target;
+
+    /** Wall clock time the attempt started */
+    FDateTime StartTime;
+
+    TArray<F_JoinTracePhase> Phases;
+
+    double TotalSeconds = 0.0;
+
+    /** Why the trace ended, e.g. "Success", "SessionIsFull" or "Abandoned" */
+    FString Outcome;
+
+    bool bSucceeded = false;
+};
+
+/**
+ * Times the phases of joining and creating games so slow joins can be broken down.
+ * Each phase is emitted as an Unreal Insights region, and finished traces are kept in a small ring buffer
+ * that can be shown on screen (StrafeUI.JoinTrace.Overlay) or written out (StrafeUI.JoinTrace.DumpCsv).
+ * The phases after travel starts (connect, teardown, map load, first tick) are recorded from engine delegates,
+ * so a trace outlives the view model that began it. Game thread only.
+ */
+struct STRAFEUI_API F_JoinTrace
+{
+    /**
+     * Starts a new trace. A trace that is still open is closed as abandoned.
+     * @param Flow The flow being measured.
+     * @param Target The server or map being joined, for display.
+     */
+    static void Begin(E_JoinTraceFlow Flow, const FString& Target);
+
+    /**
+     * Ends the current phase, if any, and starts the next one. Ignored when no trace is open.
+     * @param PhaseName Static name of the phase.
+     */
+    static void BeginPhase(const TCHAR* PhaseName);
+
+    /**
+     * Marks the start of travel. The remaining phases are recorded from the map load delegates,
+     * and the trace ends on the first tick of the new world.
+     */
+    static void BeginTravel();
+
+    /**
+     * Closes the current trace and adds it to the history. Ignored when no trace is open.
+     * @param bSucceeded Whether the attempt reached its destination.
+     * @param Outcome Short description of how the attempt ended.
+     */
+    static void End(bool bSucceeded, const FString& Outcome);
+
+    /** Whether a trace is open */
+    static bool IsActive();
+
+    /**
+     * Copies the finished traces, oldest first.
+     * @param OutRecords Receives the traces.
+     */
+    static void GetHistory(TArray<F_JoinTraceRecord>& OutRecords);
+
+    /**
+     * Writes the finished traces as CSV, one line per phase.
+     * @param FilePath The file to write.
+     * @return True if the file was written.
+     */
+    static bool DumpToCsv(const FString& FilePath);
+
+    /** Gets the default path used by DumpToCsv */
+    static FString GetDefaultCsvPath();
+};
\ No newline at end of file
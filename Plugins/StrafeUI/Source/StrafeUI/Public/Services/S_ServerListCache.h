@@ -0,0 +1,40 @@
+// Plugins/StrafeUI/Source/StrafeUI/Public/Services/S_ServerListCache.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct F_ServerInfo;
+
+/**
+ * Compact binary cache of the last successful server search.
+ * Lets the Find Game screen show the previous results immediately while a new search runs.
+ * The file starts with a magic number and a format version; mismatching files are ignored.
+ */
+struct STRAFEUI_API F_ServerListCache
+{
+    /**
+     * Writes the given servers to the cache file, replacing any previous contents.
+     * @param Servers The servers to store.
+     * @return True if the file was written.
+     */
+    static bool Save(const TArray<F_ServerInfo>& Servers);
+
+    /**
+     * Writes the given servers to the cache file on a worker thread.
+     * Saves run one after another; a save still waiting when a newer one arrives is skipped.
+     * @param Servers The servers to store.
+     */
+    static void SaveAsync(TArray<F_ServerInfo>&& Servers);
+
+    /**
+     * Reads the cached servers. The file is memory-mapped when the platform supports it.
+     * Loaded servers are marked stale.
+     * @param OutServers Receives the cached servers.
+     * @return True if a valid cache file was read.
+     */
+    static bool Load(TArray<F_ServerInfo>& OutServers);
+
+    /** Gets the path of the cache file */
+    static FString GetCacheFilePath();
+};
\ No newline at end of file
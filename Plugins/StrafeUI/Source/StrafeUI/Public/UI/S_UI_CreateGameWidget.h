@@ -39,6 +39,9 @@ private:
     UFUNCTION()
     void OnGameModeButtonSelected(UCommonButtonBase* SelectedButton, int32 ButtonIndex);
 
+    UFUNCTION()
+    void OnMapSelectionChanged(FString SelectedItem, ESelectInfo::Type SelectionType);
+
     UFUNCTION()
     void OnMaxPlayersChanged(float Value);
 
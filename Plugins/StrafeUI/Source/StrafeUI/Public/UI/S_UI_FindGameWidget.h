@@ -5,13 +5,16 @@
 #include "CoreMinimal.h"
 #include "UI/S_UI_BaseScreenWidget.h"
 #include "ViewModel/S_UI_VM_ServerBrowser.h"
+#include "UI/S_UI_ListReconciler.h"
 #include "S_UI_FindGameWidget.generated.h"
 
 class UCommonButtonBase;
 class UListView;
 class UCheckBox; // Keep this forward declaration
+class UTextBlock;
 class US_UI_CollapsibleBox;
 class US_UI_ServerFilterWidget;
+class US_UI_StringComboBox;
 
 /**
  * @class S_UI_FindGameWidget
@@ -31,12 +34,21 @@ public:
 
 protected:
     virtual void NativeOnInitialized() override;
+    virtual void NativeConstruct() override;
+    virtual void NativeDestruct() override;
 
 private:
     /** Called when the ViewModel's data has changed, refreshing the UI. */
     UFUNCTION()
     void OnServerListUpdated();
 
+    /** Called when a single server's info changed in place; rebinds its row if it is on screen. */
+    UFUNCTION()
+    void OnServerInfoUpdated(int64 SessionKey);
+
+    /** Asks the ViewModel to re-measure ping for the rows on screen and the selected server. */
+    void RefreshVisiblePings();
+
     /** Called when the user clicks on an item in the server list. */
     UFUNCTION()
     void OnServerSelected(UObject* Item);
@@ -44,6 +56,12 @@ private:
     /** Updates the enabled state of buttons based on current selection */
     void UpdateButtonStates();
 
+    /** Shows the details of the selected server in the optional details widgets; decoded on first selection */
+    void UpdateServerDetails();
+
+    /** Updates the optional status line with the number of listed servers and ingestion progress */
+    void UpdateStatusText();
+
     /** Called when filter values change */
     UFUNCTION()
     void OnFiltersChanged();
@@ -52,6 +70,13 @@ private:
     UFUNCTION()
     void HandleSearchLANChanged(bool bIsChecked);
 
+    /** Called when the optional search mode selector is changed; the only way to search LAN alone */
+    UFUNCTION()
+    void HandleSearchModeChanged(FString SelectedItem, ESelectInfo::Type SelectionType);
+
+    /** Shows the ViewModel's search mode in the LAN checkbox and the optional search mode selector */
+    void SyncSearchModeWidgets();
+
     //~ Button Click Handlers
     UFUNCTION()
     void HandleJoinClicked();
@@ -59,10 +84,23 @@ private:
     UFUNCTION()
     void HandleBackClicked();
 
+    /** Joins the best ranked server without a manual selection */
+    UFUNCTION()
+    void HandleQuickJoinClicked();
+
+    /** Sorts by the clicked column; clicking the current sort column flips the direction */
+    void HandleSortClicked(E_ServerSortColumn Column);
+
     /** The ViewModel that provides data for this widget. */
     UPROPERTY()
     TWeakObjectPtr<US_UI_VM_ServerBrowser> ViewModel;
 
+    /** Applies server list changes to List_Servers by session key */
+    F_UIListReconciler ServerListReconciler;
+
+    /** Timer driving RefreshVisiblePings */
+    FTimerHandle PingRefreshTimerHandle;
+
     //~ UPROPERTY Bindings
     UPROPERTY(meta = (BindWidget))
     TObjectPtr<UListView> List_Servers;
@@ -76,6 +114,9 @@ private:
     UPROPERTY(meta = (BindWidget))
     TObjectPtr<UCommonButtonBase> Btn_Back;
 
+    UPROPERTY(meta = (BindWidgetOptional))
+    TObjectPtr<UCommonButtonBase> Btn_QuickJoin;
+
     UPROPERTY(meta = (BindWidget))
     TObjectPtr<US_UI_CollapsibleBox> Col_Filters;
 
@@ -84,4 +125,37 @@ private:
 
     UPROPERTY(meta = (BindWidget))
     TObjectPtr<UCheckBox> Chk_SearchLAN;
+
+    /** Optional selector offering every search mode, one option per E_ServerSearchMode value in declaration order */
+    UPROPERTY(meta = (BindWidgetOptional))
+    TObjectPtr<US_UI_StringComboBox> Cmb_SearchMode;
+
+    UPROPERTY(meta = (BindWidgetOptional))
+    TObjectPtr<UTextBlock> Txt_SearchStatus;
+
+    //~ Optional details of the selected server
+    UPROPERTY(meta = (BindWidgetOptional))
+    TObjectPtr<UTextBlock> Txt_ServerDescription;
+
+    UPROPERTY(meta = (BindWidgetOptional))
+    TObjectPtr<UTextBlock> Txt_ServerRules;
+
+    UPROPERTY(meta = (BindWidgetOptional))
+    TObjectPtr<UTextBlock> Txt_ServerPlayers;
+
+    //~ Optional column headers for sorting
+    UPROPERTY(meta = (BindWidgetOptional))
+    TObjectPtr<UCommonButtonBase> Btn_SortName;
+
+    UPROPERTY(meta = (BindWidgetOptional))
+    TObjectPtr<UCommonButtonBase> Btn_SortMap;
+
+    UPROPERTY(meta = (BindWidgetOptional))
+    TObjectPtr<UCommonButtonBase> Btn_SortGameMode;
+
+    UPROPERTY(meta = (BindWidgetOptional))
+    TObjectPtr<UCommonButtonBase> Btn_SortPlayers;
+
+    UPROPERTY(meta = (BindWidgetOptional))
+    TObjectPtr<UCommonButtonBase> Btn_SortPing;
 };
\ No newline at end of file
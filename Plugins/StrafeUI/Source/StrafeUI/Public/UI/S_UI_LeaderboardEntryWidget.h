@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "CommonUserWidget.h"
 #include "Blueprint/IUserObjectListEntry.h"
+#include "UI/S_UI_ListReconciler.h"
 #include "S_UI_LeaderboardEntryWidget.generated.h"
 
 class UCommonTextBlock;
@@ -15,7 +16,7 @@ class UImage;
  * Widget representing a single leaderboard entry
  */
 UCLASS(Abstract)
-class STRAFEUI_API US_UI_LeaderboardEntryWidget : public UCommonUserWidget, public IUserObjectListEntry
+class STRAFEUI_API US_UI_LeaderboardEntryWidget : public UCommonUserWidget, public IUserObjectListEntry, public IRefreshableListEntry
 {
     GENERATED_BODY()
 
@@ -24,6 +25,10 @@ public:
     virtual void NativeOnListItemObjectSet(UObject* ListItemObject) override;
     // End of IUserObjectListEntry interface
 
+    // IRefreshableListEntry interface
+    virtual void RefreshListItem(UObject* ListItemObject) override;
+    // End of IRefreshableListEntry interface
+
 protected:
     virtual void NativeOnInitialized() override;
 
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "UI/S_UI_BaseScreenWidget.h"
+#include "UI/S_UI_ListReconciler.h"
 #include "S_UI_LeaderboardsWidget.generated.h"
 
 class US_UI_VM_Leaderboards;
@@ -50,6 +51,9 @@ private:
     UPROPERTY()
     TWeakObjectPtr<US_UI_VM_Leaderboards> ViewModel;
 
+    /** Applies leaderboard changes to ListView_Leaderboard by player and map */
+    F_UIListReconciler LeaderboardListReconciler;
+
     // UI Bindings
     UPROPERTY(meta = (BindWidget))
     TObjectPtr<UComboBoxString> ComboBox_MapFilter;
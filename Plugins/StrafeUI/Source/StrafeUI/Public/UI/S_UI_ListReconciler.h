@@ -0,0 +1,75 @@
+// Plugins/StrafeUI/Source/StrafeUI/Public/UI/S_UI_ListReconciler.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "S_UI_ListReconciler.generated.h"
+
+class UListView;
+
+UINTERFACE(MinimalAPI)
+class URefreshableListEntry : public UInterface
+{
+    GENERATED_BODY()
+};
+
+/**
+ * Implemented by list entry widgets that can rebind to their item in place.
+ * Used by F_UIListReconciler to update a realised row without regenerating it.
+ */
+class IRefreshableListEntry
+{
+    GENERATED_BODY()
+
+public:
+    /**
+     * Re-reads the item's data into the entry widget.
+     * @param ListItemObject The item the entry is currently displaying.
+     */
+    virtual void RefreshListItem(UObject* ListItemObject) = 0;
+};
+
+/**
+ * Applies keyed insert/remove/move/update diffs to a UListView instead of clearing and repopulating it.
+ *
+ * Items are matched by a stable key. Rows whose item survives a refresh keep their entry widget, selection
+ * and scroll position. Rows whose content hash changed are rebound in place through IRefreshableListEntry.
+ * The reconciler remembers the content hash of every listed key, so one instance belongs to one list view.
+ */
+struct STRAFEUI_API F_UIListReconciler
+{
+    /** Returns the stable key of an item */
+    using FGetKey = TFunctionRef<uint64(const UObject*)>;
+
+    /** Returns a hash of the item's displayed content */
+    using FGetContentHash = TFunctionRef<uint32(const UObject*)>;
+
+    /** Summary of the operations applied by Reconcile */
+    struct FResult
+    {
+        int32 Inserted = 0;
+        int32 Removed = 0;
+        int32 Moved = 0;
+        int32 Updated = 0;
+
+        bool HasChanges() const { return Inserted + Removed + Moved + Updated > 0; }
+    };
+
+    /**
+     * Brings the list view's items in line with NewItems.
+     * @param ListView The list view to update.
+     * @param NewItems The desired items, in display order.
+     * @param GetKey Returns the stable key of an item.
+     * @param GetContentHash Returns a hash of the displayed content of an item.
+     * @return The operations that were applied.
+     */
+    FResult Reconcile(UListView& ListView, const TArray<UObject*>& NewItems, FGetKey GetKey, FGetContentHash GetContentHash);
+
+    /** Forgets all remembered content hashes. Call after the list view was cleared by other means. */
+    void Reset();
+
+private:
+    /** Content hash of every key currently in the list view */
+    TMap<uint64, uint32> ContentHashByKey;
+};
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "CommonUserWidget.h"
 #include "Blueprint/IUserObjectListEntry.h"
+#include "UI/S_UI_ListReconciler.h"
 #include "S_UI_ReplayListEntryWidget.generated.h"
 
 class UCommonTextBlock;
@@ -14,7 +15,7 @@ class UImage;
  * Widget representing a single replay file in the replays list
  */
 UCLASS(Abstract)
-class STRAFEUI_API US_UI_ReplayListEntryWidget : public UCommonUserWidget, public IUserObjectListEntry
+class STRAFEUI_API US_UI_ReplayListEntryWidget : public UCommonUserWidget, public IUserObjectListEntry, public IRefreshableListEntry
 {
     GENERATED_BODY()
 
@@ -23,6 +24,10 @@ public:
     virtual void NativeOnListItemObjectSet(UObject* ListItemObject) override;
     // End of IUserObjectListEntry interface
 
+    // IRefreshableListEntry interface
+    virtual void RefreshListItem(UObject* ListItemObject) override;
+    // End of IRefreshableListEntry interface
+
 protected:
     virtual void NativePreConstruct() override;
 
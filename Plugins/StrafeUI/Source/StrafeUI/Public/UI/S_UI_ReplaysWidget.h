@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "UI/S_UI_BaseScreenWidget.h"
+#include "UI/S_UI_ListReconciler.h"
 #include "S_UI_ReplaysWidget.generated.h"
 
 class US_UI_VM_Replays;
@@ -60,6 +61,9 @@ private:
     UPROPERTY()
     TWeakObjectPtr<US_UI_VM_Replays> ViewModel;
 
+    /** Applies replay list changes to ListView_Replays by file name */
+    F_UIListReconciler ReplayListReconciler;
+
     // UI Bindings
     UPROPERTY(meta = (BindWidget))
     TObjectPtr<UListView> ListView_Replays;
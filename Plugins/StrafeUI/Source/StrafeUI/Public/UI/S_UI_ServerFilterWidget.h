@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "CommonUserWidget.h"
+#include "ViewModel/S_UI_ServerTable.h"
 #include "S_UI_ServerFilterWidget.generated.h"
 
 class UEditableTextBox;
@@ -38,6 +39,10 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Server Filter")
     FString GetGameModeFilter() const;
 
+    /** Gets the current map filter */
+    UFUNCTION(BlueprintCallable, Category = "Server Filter")
+    FString GetMapNameFilter() const;
+
     /** Gets whether to hide full servers */
     UFUNCTION(BlueprintCallable, Category = "Server Filter")
     bool GetHideFullServers() const;
@@ -58,6 +63,14 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Server Filter")
     void ResetFilters();
 
+    /**
+     * Shows how many servers each option matches. Options are only rebuilt when the counts changed,
+     * and the current selections are kept even when no server matches them anymore.
+     * @param GameModeNames, MapNames The tables the facet counts are indexed by.
+     * @param bThrottle Whether results are still streaming in, in which case the counts are applied at most every FacetRefreshIntervalSeconds.
+     */
+    void SetFacetCounts(const F_ServerFacetCounts& Facets, const F_ServerNameTable& GameModeNames, const F_ServerNameTable& MapNames, bool bThrottle = false);
+
 protected:
     virtual void NativeOnInitialized() override;
 
@@ -69,6 +82,9 @@ private:
     UFUNCTION()
     void OnGameModeSelectionChanged(FString SelectedItem, ESelectInfo::Type SelectionType);
 
+    UFUNCTION()
+    void OnMapNameSelectionChanged(FString SelectedItem, ESelectInfo::Type SelectionType);
+
     UFUNCTION()
     void OnHideFullServersChanged(bool bIsChecked);
 
@@ -84,6 +100,31 @@ private:
     /** Broadcasts that filters have changed */
     void BroadcastFilterChange();
 
+    /**
+     * Fills a combo box with an "All" option followed by one option per value, labelled with its server count.
+     * When the listed values are unchanged only the labels are updated, so an open dropdown stays open.
+     * @param Counts Servers per value ID of Names.
+     * @param DefaultValues Values listed first and even without servers; the rest follow by descending count.
+     * @param InOutOptionValues Maps each option label to the value it filters by.
+     */
+    static void RebuildFacetOptions(US_UI_StringComboBox* ComboBox, const TArray<int32>& Counts, const F_ServerNameTable& Names,
+        TArrayView<const FString> DefaultValues, int32 NumServers, TMap<FString, FString>& InOutOptionValues);
+
+    /** Returns the value the selected option of a combo box filters by; empty for "All" */
+    static FString GetSelectedOptionValue(const US_UI_StringComboBox* ComboBox, const TMap<FString, FString>& OptionValues);
+
+    /** Filter value of each game mode option label */
+    TMap<FString, FString> GameModeOptionValues;
+
+    /** Filter value of each map option label */
+    TMap<FString, FString> MapOptionValues;
+
+    /** Revision of the facet counts the options were last built from */
+    uint32 AppliedFacetRevision = 0;
+
+    /** Time the facet counts were last applied, for throttling while results stream in */
+    double LastFacetApplySeconds = 0.0;
+
     // UI Bindings
     UPROPERTY(meta = (BindWidget))
     TObjectPtr<UEditableTextBox> Txt_ServerName;
@@ -105,4 +146,17 @@ private:
 
     UPROPERTY(meta = (BindWidget))
     TObjectPtr<UTextBlock> Txt_MaxPingValue;
+
+    UPROPERTY(meta = (BindWidgetOptional))
+    TObjectPtr<US_UI_StringComboBox> Cmb_MapName;
+
+    //~ Optional server counts shown next to the checkboxes
+    UPROPERTY(meta = (BindWidgetOptional))
+    TObjectPtr<UTextBlock> Txt_FullServerCount;
+
+    UPROPERTY(meta = (BindWidgetOptional))
+    TObjectPtr<UTextBlock> Txt_EmptyServerCount;
+
+    UPROPERTY(meta = (BindWidgetOptional))
+    TObjectPtr<UTextBlock> Txt_PrivateServerCount;
 };
\ No newline at end of file
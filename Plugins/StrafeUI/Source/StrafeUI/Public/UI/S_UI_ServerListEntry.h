@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "CommonUserWidget.h"
 #include "Blueprint/IUserObjectListEntry.h"
+#include "UI/S_UI_ListReconciler.h"
 #include "S_UI_ServerListEntry.generated.h"
 
 class UCommonTextBlock;
@@ -15,7 +16,7 @@ class UProgressBar;
  * Widget representing a single server in the server browser list
  */
 UCLASS(Abstract)
-class STRAFEUI_API US_UI_ServerListEntry : public UCommonUserWidget, public IUserObjectListEntry
+class STRAFEUI_API US_UI_ServerListEntry : public UCommonUserWidget, public IUserObjectListEntry, public IRefreshableListEntry
 {
     GENERATED_BODY()
 
@@ -24,22 +25,14 @@ public:
     virtual void NativeOnListItemObjectSet(UObject* ListItemObject) override;
     // End of IUserObjectListEntry interface
 
+    // IRefreshableListEntry interface
+    virtual void RefreshListItem(UObject* ListItemObject) override;
+    // End of IRefreshableListEntry interface
+
 protected:
     virtual void NativePreConstruct() override;
 
 private:
-    /** Updates the visual state based on server capacity */
-    void UpdateServerStatusVisuals();
-
-    /** Formats the player count text */
-    FText GetPlayerCountText(int32 CurrentPlayers, int32 MaxPlayers) const;
-
-    /** Gets the color for ping display */
-    FLinearColor GetPingColor(int32 Ping) const;
-
-    /** Gets the color for server status */
-    FLinearColor GetServerStatusColor(int32 CurrentPlayers, int32 MaxPlayers) const;
-
     // UI Bindings
     UPROPERTY(meta = (BindWidget))
     TObjectPtr<UCommonTextBlock> Txt_ServerName;
@@ -13,4 +13,11 @@ UCLASS()
 class STRAFEUI_API US_UI_StringComboBox : public UComboBoxString
 {
     GENERATED_BODY()
+
+public:
+    /**
+     * Relabels an option in place. Unlike clearing and re-adding options, this keeps the selection and an open dropdown.
+     * @return False if Index is not a valid option index.
+     */
+    bool SetOptionAtIndex(int32 Index, const FString& Option);
 };
\ No newline at end of file
@@ -0,0 +1,72 @@
+// Plugins/StrafeUI/Source/StrafeUI/Public/ViewModel/S_UI_ObjectPool.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+
+/**
+ * @class TS_UI_ObjectPool
+ * @brief Typed pool of list-item view-model objects, owned by a view model.
+ *
+ * Released objects are reset through their ResetForPool() method and handed out again
+ * by Acquire() instead of allocating, so refreshes stop producing garbage. The owner must
+ * report pooled objects to the garbage collector by calling AddReferencedObjects from its
+ * own static AddReferencedObjects override.
+ */
+template <typename ObjectType>
+class TS_UI_ObjectPool
+{
+public:
+	/**
+	 * Returns a pooled object, or a new one if the pool is empty.
+	 * @param Outer The outer for newly allocated objects.
+	 */
+	ObjectType* Acquire(UObject* Outer)
+	{
+		if (FreeObjects.Num() > 0)
+		{
+			++ReuseCount;
+			return FreeObjects.Pop(EAllowShrinking::No);
+		}
+
+		++AllocationCount;
+		return NewObject<ObjectType>(Outer);
+	}
+
+	/** Resets an object and returns it to the pool. The caller must not keep using it. */
+	void Release(ObjectType* Object)
+	{
+		if (Object)
+		{
+			Object->ResetForPool();
+			FreeObjects.Add(Object);
+		}
+	}
+
+	/** Drops every pooled object, leaving them to the garbage collector */
+	void Empty()
+	{
+		FreeObjects.Empty();
+	}
+
+	/** Reports the pooled objects to the garbage collector */
+	void AddReferencedObjects(FReferenceCollector& Collector)
+	{
+		Collector.AddReferencedObjects(FreeObjects);
+	}
+
+	/** Number of objects waiting to be reused */
+	int32 GetNumFree() const { return FreeObjects.Num(); }
+
+	/** Number of objects Acquire() had to allocate */
+	int32 GetAllocationCount() const { return AllocationCount; }
+
+	/** Number of objects Acquire() served from the pool */
+	int32 GetReuseCount() const { return ReuseCount; }
+
+private:
+	TArray<TObjectPtr<ObjectType>> FreeObjects;
+	int32 AllocationCount = 0;
+	int32 ReuseCount = 0;
+};
\ No newline at end of file
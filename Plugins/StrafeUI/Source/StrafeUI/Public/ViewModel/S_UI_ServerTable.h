@@ -0,0 +1,378 @@
+// Plugins/StrafeUI/Source/StrafeUI/Public/ViewModel/S_UI_ServerTable.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ViewModel/S_UI_TrigramIndex.h"
+#include "S_UI_ServerTable.generated.h"
+
+struct F_ServerInfo;
+
+/**
+ * Columns the server browser can sort by.
+ */
+UENUM(BlueprintType)
+enum class E_ServerSortColumn : uint8
+{
+	None		UMETA(DisplayName = "None"),
+	Ping		UMETA(DisplayName = "Ping"),
+	Players		UMETA(DisplayName = "Players"),
+	Name		UMETA(DisplayName = "Name"),
+	Map			UMETA(DisplayName = "Map"),
+	GameMode	UMETA(DisplayName = "Game Mode"),
+
+	Count		UMETA(Hidden)
+};
+
+/**
+ * Per-row flag bits stored in F_ServerTable::Flags.
+ */
+enum class E_ServerRowFlags : int32
+{
+	None	= 0,
+	Private	= 1 << 0,
+	LAN		= 1 << 1,
+	Full	= 1 << 2,
+	Empty	= 1 << 3,
+	/** Loaded from the on-disk cache and not yet confirmed by a live search */
+	Stale	= 1 << 4,
+	/** Replaced by a newer row for the same server; always filtered out */
+	Superseded	= 1 << 5
+};
+ENUM_CLASS_FLAGS(E_ServerRowFlags);
+
+/**
+ * @struct F_ServerNumericFilter
+ * @brief The numeric and flag predicates of the server browser filters.
+ * A row passes if Ping <= MaxPing and none of its flags are in RejectFlags.
+ */
+struct F_ServerNumericFilter
+{
+	int32 MaxPing = MAX_int32;
+	E_ServerRowFlags RejectFlags = E_ServerRowFlags::None;
+};
+
+/** How a filter change relates to the previously applied filter */
+enum class E_ServerFilterChange : uint8
+{
+	/** Nothing that affects the result changed */
+	None,
+	/** Every row rejected before is still rejected */
+	Narrowed,
+	/** Every row accepted before is still accepted */
+	Widened,
+	/** Rows can move in both directions */
+	Mixed
+};
+
+/**
+ * @struct F_ServerFilterState
+ * @brief Snapshot of every server browser filter, with text queries already lowercased.
+ */
+struct F_ServerFilterState
+{
+	F_ServerNumericFilter Numeric;
+	FString LowerServerName;
+
+	/** Interned IDs of the exact game mode and map to show, or INDEX_NONE for any */
+	int32 GameModeId = INDEX_NONE;
+	int32 MapId = INDEX_NONE;
+
+	bool bSearchDescriptions = false;
+
+	/** Classifies the change from OldState to NewState */
+	static E_ServerFilterChange Compare(const F_ServerFilterState& OldState, const F_ServerFilterState& NewState);
+};
+
+/**
+ * @struct F_ServerSearchQuery
+ * @brief The filters a session search can evaluate on the backend.
+ *
+ * Servers rejected here are never downloaded, so a search only stays usable while
+ * the local filters are at least as strict as the query it was made with.
+ */
+struct F_ServerSearchQuery
+{
+	bool bNonEmptyOnly = false;
+	bool bOpenSlotsOnly = false;
+	FString GameMode;
+	FString MapName;
+
+	/** Whether every server matching Other also matches this query */
+	bool Includes(const F_ServerSearchQuery& Other) const;
+};
+
+/**
+ * @struct F_ServerRowText
+ * @brief The lowercased free-text columns of one row. Can be built off the game thread ahead of AddRow.
+ */
+struct F_ServerRowText
+{
+	FString LowerName;
+	FString LowerDescription;
+
+	/**
+	 * Lowercases the text fields of a server.
+	 * @param Description The server description, which is indexed for search but not kept in F_ServerInfo.
+	 */
+	static F_ServerRowText Make(const F_ServerInfo& ServerInfo, const FString& Description = FString());
+};
+
+/**
+ * @struct F_ServerScoreWeights
+ * @brief How strongly each column counts when ranking servers for Quick Join.
+ */
+struct F_ServerScoreWeights
+{
+	/** Score lost per millisecond of ping */
+	float PingWeight = 1.0f;
+
+	/** Score of a full server relative to an empty one; scaled by the fill ratio */
+	float FillWeight = 0.0f;
+
+	/** Interned game mode that earns GameModeBonus, or INDEX_NONE for no preference */
+	int32 PreferredGameModeId = INDEX_NONE;
+	float GameModeBonus = 0.0f;
+};
+
+/**
+ * @class F_ServerNameTable
+ * @brief Interns the values of a repeated text column, such as game modes or maps, as small integer IDs.
+ *
+ * Thousands of servers share a handful of values, so each value is stored once with a single
+ * display text that every server with that value shares. Lookups ignore case, and the first
+ * spelling seen becomes the display text. IDs stay valid for the lifetime of the table, and
+ * interning is thread safe so decode tasks can intern while the game thread filters.
+ */
+class STRAFEUI_API F_ServerNameTable
+{
+public:
+	/**
+	 * Returns the ID of a value, adding it if it is new.
+	 * @param OutDisplayName Receives the shared display text of the value.
+	 * @return INDEX_NONE for an empty value.
+	 */
+	int32 Intern(const FString& Value, FText& OutDisplayName);
+
+	/** Returns the ID of a value, adding it if it is new. INDEX_NONE for an empty value. */
+	int32 Intern(const FString& Value);
+
+	/** Returns the ID of a value without adding it, or INDEX_NONE if it was never interned */
+	int32 Find(const FString& Value) const;
+
+	/** Returns the shared display text of an ID; empty for INDEX_NONE */
+	FText GetDisplayName(int32 Id) const;
+
+	/** Case-insensitive ordering of two IDs by value. INDEX_NONE sorts first. */
+	bool IsLess(int32 IdA, int32 IdB) const;
+
+	/** Number of interned values; IDs are [0, Num()) */
+	int32 Num() const;
+
+private:
+	mutable FRWLock Lock;
+	TArray<FText> DisplayNames;
+	TArray<FString> LowerNames;
+
+	/** FString keys hash and compare without case */
+	TMap<FString, int32> IdsByName;
+};
+
+/**
+ * @struct F_ServerFacetCounts
+ * @brief How many servers each filter option matches, ignoring the other filters.
+ * Only live rows count; superseded rows are subtracted as they are replaced.
+ */
+struct F_ServerFacetCounts
+{
+	/** Servers per interned game mode and map ID; zero for values no row has anymore */
+	TArray<int32> GameModeCounts;
+	TArray<int32> MapCounts;
+
+	int32 NumServers = 0;
+	int32 NumFull = 0;
+	int32 NumEmpty = 0;
+	int32 NumPrivate = 0;
+
+	/** Bumped on every change, so views can skip rebuilding options when nothing moved */
+	uint32 Revision = 0;
+};
+
+/**
+ * @struct F_ServerTable
+ * @brief Column-oriented copy of the server list used for filtering.
+ *
+ * Every column is indexed by row, and rows are kept in the same order as the
+ * browser's entry list. Numeric columns are packed int32 arrays so the numeric
+ * filter can be evaluated four rows at a time without branches. Game modes and
+ * maps are interned IDs, so filtering and counting them are integer compares.
+ * Names and descriptions are stored lowercased once so text filters never
+ * convert per query, and are trigram-indexed as rows are added so substring
+ * searches only verify candidate rows. Sort orders are
+ * kept as row permutations per column, built on first use and extended by
+ * merging as rows are appended.
+ */
+struct STRAFEUI_API F_ServerTable
+{
+	TArray<int32> Pings;
+	TArray<int32> PlayerCounts;
+	TArray<int32> MaxPlayers;
+	TArray<int32> Flags;
+	TArray<int32> GameModeIds;
+	TArray<int32> MapIds;
+	TArray<FString> LowerNames;
+	TArray<FString> LowerDescriptions;
+
+	/** Shared with decode tasks, and kept across resets so the IDs held by entries stay valid */
+	TSharedRef<F_ServerNameTable> GameModeNames = MakeShared<F_ServerNameTable>();
+	TSharedRef<F_ServerNameTable> MapNames = MakeShared<F_ServerNameTable>();
+
+	F_TrigramIndex NameIndex;
+	F_TrigramIndex DescriptionIndex;
+
+	/** Counted as rows are added, updated and superseded, so filter options never need a pass of their own */
+	F_ServerFacetCounts Facets;
+
+	/** Appends a row built from the given server info. Returns the row index. */
+	int32 AddRow(const F_ServerInfo& ServerInfo);
+
+	/** Appends a row whose text columns were already lowercased. Returns the row index. */
+	int32 AddRow(const F_ServerInfo& ServerInfo, F_ServerRowText&& RowText);
+
+	/** Removes all rows */
+	void Reset();
+
+	/** Reserves space for the given number of rows */
+	void Reserve(int32 NumRows);
+
+	/** Number of rows in the table */
+	int32 Num() const { return Pings.Num(); }
+
+	/**
+	 * Evaluates the numeric filter over rows [FirstRow, Num()) and writes the result into a selection bitmap.
+	 * Bits for rows before FirstRow are left untouched; the bitmap is grown to cover every row.
+	 * @param Filter The predicates to evaluate.
+	 * @param FirstRow The first row to evaluate.
+	 * @param InOutSelection Bitmap with one bit per row, 32 rows per word.
+	 */
+	void FilterNumeric(const F_ServerNumericFilter& Filter, int32 FirstRow, TArray<uint32>& InOutSelection) const;
+
+	/**
+	 * Returns the rows in order of the given column, with secondary keys breaking ties in the same way for either direction.
+	 * Built on first use per column and direction and kept up to date as rows are added.
+	 * @param Column The column to sort by. None returns the rows in insertion order.
+	 * @param bDescending Whether the column is sorted from highest to lowest.
+	 */
+	const TArray<int32>& GetSortPermutation(E_ServerSortColumn Column, bool bDescending);
+
+	/**
+	 * Updates the ping of a row. Ping is a sort key for every column, so the row is moved within the active sort order
+	 * and the other cached orders are dropped to be rebuilt when next requested.
+	 * @param ActiveColumn The column the view is sorted by.
+	 * @param bActiveDescending Whether the view is sorted from highest to lowest.
+	 */
+	void SetPing(int32 Row, int32 Ping, E_ServerSortColumn ActiveColumn, bool bActiveDescending);
+
+	/** Copies the text columns of a row, for re-adding it to a rebuilt table */
+	F_ServerRowText GetRowText(int32 Row) const;
+
+	/** Whether a row's free-text columns equal the given text, in which case the row can be updated in place */
+	bool HasSameText(int32 Row, const F_ServerRowText& RowText) const;
+
+	/**
+	 * Updates the numeric and interned columns and the flags of a row from newer info for the same server.
+	 * Free-text columns are indexed and cannot change in place; check HasSameText first.
+	 * @return True if any column changed.
+	 */
+	bool UpdateNumeric(int32 Row, const F_ServerInfo& ServerInfo);
+
+	/** Marks a row as replaced by a newer row for the same server */
+	void MarkSuperseded(int32 Row);
+
+	/** Scores a row for Quick Join. Higher is better. */
+	float ScoreRow(const F_ServerScoreWeights& Weights, int32 Row) const;
+
+	/**
+	 * Finds the best scoring joinable rows among the selected ones, using a bounded heap instead of sorting every row.
+	 * Private, full and stale rows are skipped.
+	 * @param Selection One bit per row, as produced by FilterNumeric.
+	 * @param Count Maximum number of rows to return.
+	 * @param OutRows Receives the rows, best first.
+	 */
+	void SelectBestRows(const TArray<uint32>& Selection, const F_ServerScoreWeights& Weights, int32 Count, TArray<int32>& OutRows) const;
+
+	/** Scalar evaluation of the numeric filter for a single row */
+	bool PassesNumeric(const F_ServerNumericFilter& Filter, int32 Row) const
+	{
+		return Pings[Row] <= Filter.MaxPing && (Flags[Row] & (int32)Filter.RejectFlags) == 0;
+	}
+
+	/** Returns whether the given row is set in a selection bitmap */
+	static bool IsSelected(const TArray<uint32>& Selection, int32 Row)
+	{
+		return (Selection[Row >> 5] & (1u << (Row & 31))) != 0;
+	}
+
+	/** Calls Func(Row) for every set row at or after FirstRow, in increasing order. Func may clear bits. */
+	template <typename FuncType>
+	static void ForEachSelected(const TArray<uint32>& Selection, int32 FirstRow, FuncType&& Func)
+	{
+		const int32 FirstWord = FirstRow >> 5;
+		for (int32 Word = FirstWord; Word < Selection.Num(); ++Word)
+		{
+			uint32 Bits = Selection[Word];
+			if (Word == FirstWord)
+			{
+				Bits &= ~((1u << (FirstRow & 31)) - 1);
+			}
+
+			while (Bits != 0)
+			{
+				const int32 Row = (Word << 5) + (int32)FMath::CountTrailingZeros(Bits);
+				Bits &= Bits - 1;
+				Func(Row);
+			}
+		}
+	}
+
+	/** Calls Func(Row) for every clear row below NumRows, in increasing order. Func may set bits. */
+	template <typename FuncType>
+	static void ForEachRejected(const TArray<uint32>& Selection, int32 NumRows, FuncType&& Func)
+	{
+		for (int32 Word = 0; Word < Selection.Num(); ++Word)
+		{
+			uint32 Bits = ~Selection[Word];
+			const int32 RowsInWord = FMath::Min(NumRows - (Word << 5), 32);
+			if (RowsInWord < 32)
+			{
+				Bits &= (1u << RowsInWord) - 1;
+			}
+
+			while (Bits != 0)
+			{
+				const int32 Row = (Word << 5) + (int32)FMath::CountTrailingZeros(Bits);
+				Bits &= Bits - 1;
+				Func(Row);
+			}
+		}
+	}
+
+	/** Computes the flag bits for a server */
+	static E_ServerRowFlags ComputeFlags(const F_ServerInfo& ServerInfo);
+
+private:
+	/** Strict ordering of two rows for a column, including secondary keys. Only the column itself is reversed when descending. */
+	bool IsRowLess(E_ServerSortColumn Column, bool bDescending, int32 RowA, int32 RowB) const;
+
+	/** Index into SortPermutations of a column and direction */
+	static int32 GetPermutationIndex(E_ServerSortColumn Column, bool bDescending) { return (int32)Column * 2 + (bDescending ? 1 : 0); }
+
+	/** Adds Delta to the full, empty and private tallies of the given flags */
+	void CountFlagFacets(int32 RowFlags, int32 Delta);
+
+	/** Adds Delta to every facet of a row */
+	void CountRowFacets(int32 Row, int32 Delta);
+
+	/** Cached permutation per sort column and direction; empty until first requested */
+	TArray<int32> SortPermutations[(int32)E_ServerSortColumn::Count * 2];
+};
@@ -0,0 +1,64 @@
+// Plugins/StrafeUI/Source/StrafeUI/Public/ViewModel/S_UI_SessionResultArena.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FOnlineSessionSearch;
+class FOnlineSessionSearchResult;
+
+/**
+ * @struct F_SessionResultHandle
+ * @brief Refers to one search result stored in an F_SessionResultArena.
+ * Handles from an earlier arena generation no longer resolve.
+ */
+struct F_SessionResultHandle
+{
+	uint32 Generation = 0;
+	int32 SearchIndex = INDEX_NONE;
+	int32 ResultIndex = INDEX_NONE;
+
+	bool IsSet() const { return Generation != 0; }
+};
+
+/**
+ * @class F_SessionResultArena
+ * @brief Shared, immutable storage for the results of completed session searches.
+ *
+ * The arena adopts the search objects themselves, so results are never copied; list
+ * entries keep only a handle. Adopted searches must not be modified afterwards.
+ */
+class STRAFEUI_API F_SessionResultArena
+{
+public:
+	/** Drops every adopted search and starts a new generation, invalidating all existing handles */
+	void Reset();
+
+	/**
+	 * Takes shared ownership of a completed search.
+	 * @return The index of the search within the current generation, for MakeHandle.
+	 */
+	int32 AddSearch(const TSharedRef<FOnlineSessionSearch>& Search);
+
+	/** Number of searches adopted in the current generation; the index the next search will get */
+	int32 Num() const { return Searches.Num(); }
+
+	/**
+	 * Drops the searches adopted before FirstKept without starting a new generation.
+	 * Handles into the dropped searches stop resolving; every other handle stays valid.
+	 */
+	void ReleaseSearchesBefore(int32 FirstKept);
+
+	/** Builds a handle to a result of an adopted search */
+	F_SessionResultHandle MakeHandle(int32 SearchIndex, int32 ResultIndex) const;
+
+	/** Returns the result a handle refers to, or nullptr if the handle is unset or from an earlier generation */
+	const FOnlineSessionSearchResult* Resolve(const F_SessionResultHandle& Handle) const;
+
+private:
+	/** Searches adopted in the current generation. Released searches leave a null slot so later indices stay put. */
+	TArray<TSharedPtr<const FOnlineSessionSearch>> Searches;
+
+	/** Incremented by Reset. Zero is reserved for unset handles. */
+	uint32 Generation = 1;
+};
\ No newline at end of file
@@ -0,0 +1,45 @@
+// Plugins/StrafeUI/Source/StrafeUI/Public/ViewModel/S_UI_TrigramIndex.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * @struct F_TrigramIndex
+ * @brief Inverted index from three-character substrings to the rows that contain them.
+ *
+ * A substring query is answered by intersecting the posting lists of the query's
+ * trigrams, which yields a small candidate set that still has to be verified with
+ * a real substring test. Text is expected to be lowercased by the caller.
+ * Rows must be added in increasing order so posting lists stay sorted.
+ */
+struct STRAFEUI_API F_TrigramIndex
+{
+	/** Queries shorter than this cannot use the index */
+	static constexpr int32 MinQueryLength = 3;
+
+	/** Indexes the text of a row. Rows must be added in increasing order. */
+	void AddRow(int32 Row, const FString& LowerText);
+
+	/** Removes all rows */
+	void Reset();
+
+	/**
+	 * Finds the rows at or after FirstRow that contain every trigram of the query.
+	 * @param LowerQuery The lowercased substring to look for.
+	 * @param FirstRow Rows before this are ignored.
+	 * @param OutRows Receives candidate rows in increasing order. Candidates must still be verified.
+	 * @return False if the query is too short to use the index, in which case every row is a candidate.
+	 */
+	bool FindCandidates(const FString& LowerQuery, int32 FirstRow, TArray<int32>& OutRows) const;
+
+private:
+	/** Packs three characters into a single key */
+	static uint64 MakeTrigram(const TCHAR* Chars)
+	{
+		return (uint64)(uint32)Chars[0] | ((uint64)(uint32)Chars[1] << 21) | ((uint64)(uint32)Chars[2] << 42);
+	}
+
+	/** Sorted rows containing each trigram */
+	TMap<uint64, TArray<int32>> Postings;
+};
\ No newline at end of file
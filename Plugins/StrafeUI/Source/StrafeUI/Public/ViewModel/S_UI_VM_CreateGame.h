@@ -6,10 +6,13 @@
 #include "ViewModel/S_UI_ViewModelBase.h"
 #include "OnlineSessionSettings.h"
 #include "Interfaces/OnlineSessionInterface.h"
+#include "Engine/StreamableManager.h"
+#include "Containers/Ticker.h"
 #include "S_UI_VM_CreateGame.generated.h"
 
 class US_UI_Settings;
 struct FStrafeGameModeInfo;
+struct F_SessionOperationReport;
 
 UCLASS(BlueprintType)
 class STRAFEUI_API US_UI_VM_CreateGame : public US_UI_ViewModelBase
@@ -25,6 +28,10 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Create Game")
 	void OnGameModeChanged(FString SelectedGameModeName);
 
+	/** Selects a map of the current game mode and starts loading it in the background. */
+	UFUNCTION(BlueprintCallable, Category = "Create Game")
+	void OnMapChanged(FString InSelectedMapName);
+
 	/** List of game mode names to display in the UI. */
 	UPROPERTY(BlueprintReadOnly, Category = "Create Game")
 	TArray<FString> GameModeDisplayNames;
@@ -75,26 +82,35 @@ public:
 	float RespawnTime = 5.0f;
 
 private:
-	/** Callback for when session creation completes */
-	void OnCreateSessionComplete(FName SessionName, bool bWasSuccessful);
+	/** Callback for when the session has been created and started, or either step failed */
+	void OnCreateSessionComplete(const F_SessionOperationReport& Report);
 
 	/** Callback for when a previous session is destroyed before creating a new one. */
-	void OnDestroySessionComplete(FName SessionName, bool bWasSuccessful);
-
-	/** Callback for when the session has been started */
-	void OnStartSessionComplete(FName SessionName, bool bWasSuccessful);
+	void OnDestroySessionComplete(const F_SessionOperationReport& Report);
 
-	/** Contains the actual logic to create the session settings and trigger the creation. */
+	/**
+	 * Contains the actual logic to create the session settings and trigger the creation.
+	 * Runs again once the game mode class has loaded if its prefetch is still in flight.
+	 */
 	void CreateNewSession();
 
-	/** Stores the delegate handle for cleanup */
-	FDelegateHandle CreateSessionCompleteDelegateHandle;
+	/** Finds the settings of the selected game mode */
+	const FStrafeGameModeInfo* FindSelectedGameModeInfo() const;
+
+	/** Finds the selected map among the maps of a game mode */
+	const TSoftObjectPtr<UWorld>* FindSelectedMapAsset(const FStrafeGameModeInfo& GameModeInfo) const;
+
+	/** Starts loading the selected game mode class and map, cancelling the loads of earlier selections */
+	void PrefetchSelection();
+
+	/** Starts an async load of Path into InOutHandle, cancelling whatever the handle loaded before. Does nothing if it already loads Path. */
+	static void Prefetch(const FSoftObjectPath& Path, TSharedPtr<FStreamableHandle>& InOutHandle, FSoftObjectPath& InOutPath);
 
-	/** Delegate handle for the destroy session callback. */
-	FDelegateHandle DestroySessionCompleteDelegateHandle;
+	/** Runs CreateNewSession on the next tick once the awaited game mode load completes or is cancelled */
+	void ResumeCreateNewSession();
 
-	/** Delegate handle for the start session callback. */
-	FDelegateHandle StartSessionCompleteDelegateHandle;
+	/** Ticker callback for ResumeCreateNewSession. Always returns false so it fires once. */
+	bool TickResumeCreateNewSession(float DeltaTime);
 
 	UPROPERTY()
 	TWeakObjectPtr<const US_UI_Settings> UISettings;
@@ -104,4 +120,22 @@ private:
 
 	/** Cached map asset path for session creation */
 	FString CachedMapAssetPath;
+
+	/** Background load of the selected game mode class */
+	TSharedPtr<FStreamableHandle> GameModeClassHandle;
+
+	/** Class GameModeClassHandle loads */
+	FSoftObjectPath GameModeClassPath;
+
+	/** Background load of the selected map package */
+	TSharedPtr<FStreamableHandle> MapHandle;
+
+	/** Map MapHandle loads */
+	FSoftObjectPath MapPath;
+
+	/** True while CreateNewSession waits for GameModeClassHandle */
+	bool bWaitingForGameModeClass = false;
+
+	/** Ticker resuming CreateNewSession after the game mode load */
+	FTSTicker::FDelegateHandle ResumeTickerHandle;
 };
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "ViewModel/S_UI_ViewModelBase.h"
 #include "Services/S_LeaderboardService.h"
+#include "ViewModel/S_UI_ObjectPool.h"
 #include "S_UI_VM_Leaderboards.generated.h"
 
 /**
@@ -30,6 +31,9 @@ public:
 
     UPROPERTY(BlueprintReadOnly)
     FString FormattedTime;
+
+    /** Clears the entry before it goes back to the entry pool */
+    void ResetForPool();
 };
 
 /**
@@ -41,6 +45,8 @@ class STRAFEUI_API US_UI_VM_Leaderboards : public US_UI_ViewModelBase
     GENERATED_BODY()
 
 public:
+    static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
+
     /** Initializes the ViewModel */
     UFUNCTION(BlueprintCallable, Category = "Leaderboards")
     void Initialize();
@@ -78,6 +84,16 @@ private:
     UPROPERTY()
     TObjectPtr<US_LeaderboardService> LeaderboardService;
 
+    /** Recycles leaderboard entries between refreshes */
+    TS_UI_ObjectPool<US_UI_VM_LeaderboardEntry> EntryPool;
+
+    /** Entries no longer listed, waiting for the view to drop them before they are reused */
+    UPROPERTY()
+    TArray<TObjectPtr<US_UI_VM_LeaderboardEntry>> RetiredEntries;
+
+    /** Returns retired entries to the pool. Call only after the view has been told the entries are gone. */
+    void ReleaseRetiredEntries();
+
     /** Formats time in seconds to MM:SS.MS format */
     FString FormatTime(float TimeInSeconds) const;
 };
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "ViewModel/S_UI_ViewModelBase.h"
 #include "Services/S_ReplayService.h"
+#include "ViewModel/S_UI_ObjectPool.h"
 #include "S_UI_VM_Replays.generated.h"
 
 /**
@@ -30,6 +31,9 @@ public:
 
     UPROPERTY(BlueprintReadOnly)
     int32 FileSizeKB;
+
+    /** Clears the entry before it goes back to the entry pool */
+    void ResetForPool();
 };
 
 /**
@@ -41,6 +45,8 @@ class STRAFEUI_API US_UI_VM_Replays : public US_UI_ViewModelBase
     GENERATED_BODY()
 
 public:
+    static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
+
     /** Initializes the ViewModel */
     void Initialize();
 
@@ -81,6 +87,9 @@ private:
     UPROPERTY()
     TObjectPtr<US_ReplayService> ReplayService;
 
+    /** Recycles replay entries between refreshes */
+    TS_UI_ObjectPool<US_UI_VM_ReplayEntry> EntryPool;
+
     /** Formats the timestamp for display */
     FString FormatTimestamp(const FDateTime& Timestamp) const;
 
@@ -4,30 +4,85 @@
 
 #include "CoreMinimal.h"
 #include "ViewModel/S_UI_ViewModelBase.h"
+#include "ViewModel/S_UI_ServerTable.h"
+#include "ViewModel/S_UI_ObjectPool.h"
+#include "ViewModel/S_UI_SessionResultArena.h"
 #include "OnlineSessionSettings.h"
 #include "Interfaces/OnlineSessionInterface.h"
+#include "Containers/Ticker.h"
+#include "Engine/StreamableManager.h"
 #include "S_UI_VM_ServerBrowser.generated.h"
 
+struct F_ServerDecodeJob;
+struct F_SessionOperationReport;
+
+/**
+ * Delegate broadcast while search results are streamed into the server list.
+ * @param IngestedCount Number of search results converted so far.
+ * @param TotalCount Total number of search results returned by the search.
+ */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnServerIngestionProgress, int32, IngestedCount, int32, TotalCount);
+
+/**
+ * Delegate broadcast when a single server's info changes in place, without the list itself changing.
+ * @param SessionKey Key of the server that changed.
+ */
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FOnServerInfoUpdated, int64, SessionKey);
+
+/**
+ * Where a server was found.
+ */
+UENUM(BlueprintType)
+enum class E_ServerSource : uint8
+{
+	Online	UMETA(DisplayName = "Online"),
+	LAN		UMETA(DisplayName = "LAN")
+};
+
+/**
+ * Which sources a server list refresh searches.
+ */
+UENUM(BlueprintType)
+enum class E_ServerSearchMode : uint8
+{
+	Online		UMETA(DisplayName = "Online"),
+	LAN			UMETA(DisplayName = "LAN"),
+	/** LAN and online searches run side by side and stream into one list */
+	Combined	UMETA(DisplayName = "LAN + Online")
+};
+
 /**
  * @struct F_ServerInfo
- * @brief Contains information about a single game server.
+ * @brief The compact summary of a single game server shown in the server list.
+ * Everything only needed once a server is inspected lives in F_ServerDetails.
  */
 USTRUCT(BlueprintType)
 struct F_ServerInfo
 {
 	GENERATED_BODY()
 
+	/** Stable key derived from the session ID. Identifies the same server across filtering and refreshes. */
+	UPROPERTY(BlueprintReadOnly, Category = "Server Info")
+	int64 SessionKey = 0;
+
 	UPROPERTY(BlueprintReadOnly, Category = "Server Info")
 	FText ServerName;
 
+	/** Shared by every server with the same game mode; see GameModeId */
 	UPROPERTY(BlueprintReadOnly, Category = "Server Info")
 	FText GameMode;
 
+	/** Shared by every server on the same map; see MapId */
 	UPROPERTY(BlueprintReadOnly, Category = "Server Info")
-	FString CurrentMap;
+	FText CurrentMap;
 
+	/** ID of GameMode in the browser's game mode name table, or INDEX_NONE if the server has none */
 	UPROPERTY(BlueprintReadOnly, Category = "Server Info")
-	FText Description;
+	int32 GameModeId = INDEX_NONE;
+
+	/** ID of CurrentMap in the browser's map name table, or INDEX_NONE if the server has none */
+	UPROPERTY(BlueprintReadOnly, Category = "Server Info")
+	int32 MapId = INDEX_NONE;
 
 	UPROPERTY(BlueprintReadOnly, Category = "Server Info")
 	int32 PlayerCount;
@@ -43,6 +98,66 @@ struct F_ServerInfo
 
 	UPROPERTY(BlueprintReadOnly, Category = "Server Info")
 	bool bIsLAN;
+
+	/** The search that found this server. When both searches report it, the first one wins. */
+	UPROPERTY(BlueprintReadOnly, Category = "Server Info")
+	E_ServerSource Source = E_ServerSource::Online;
+
+	/** True for entries loaded from the server list cache that a live search has not confirmed yet. Stale entries cannot be joined. */
+	UPROPERTY(BlueprintReadOnly, Category = "Server Info")
+	bool bIsStale = false;
+};
+
+/**
+ * @struct F_ServerDetails
+ * @brief The full record of a single game server, decoded only when the server is selected.
+ */
+USTRUCT(BlueprintType)
+struct F_ServerDetails
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "Server Details")
+	int64 SessionKey = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Server Details")
+	FText Description;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Server Details")
+	bool bFriendlyFire = false;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Server Details")
+	bool bAllowSpectators = false;
+
+	/** In minutes; 0 when the server does not advertise one */
+	UPROPERTY(BlueprintReadOnly, Category = "Server Details")
+	int32 TimeLimit = 0;
+
+	UPROPERTY(BlueprintReadOnly, Category = "Server Details")
+	int32 ScoreLimit = 0;
+
+	/** In seconds */
+	UPROPERTY(BlueprintReadOnly, Category = "Server Details")
+	float RespawnTime = 0.0f;
+
+	/** Names of the connected players, for servers that advertise them */
+	UPROPERTY(BlueprintReadOnly, Category = "Server Details")
+	TArray<FString> PlayerNames;
+};
+
+/**
+ * @struct F_ServerRowDisplay
+ * @brief The formatted text, colors and opacity of one server list row.
+ * Built when the server info changes, so binding a recycled row widget only copies values.
+ */
+struct F_ServerRowDisplay
+{
+	FText PlayerCount;
+	FText Ping;
+	FLinearColor PingColor = FLinearColor::White;
+	FLinearColor CapacityColor = FLinearColor::White;
+	float FillPercent = 0.0f;
+	float Opacity = 1.0f;
 };
 
 /**
@@ -59,8 +174,42 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category = "Server Info")
 	F_ServerInfo ServerInfo;
 
-	/** The full session search result needed for joining */
-	FOnlineSessionSearchResult SessionSearchResult;
+	/** Refers to the search result needed for joining, stored once in the browser's result arena. Unset for cached entries. */
+	F_SessionResultHandle SessionResult;
+
+	/** What the row widget shows for ServerInfo; call UpdateDisplay whenever ServerInfo changes */
+	F_ServerRowDisplay Display;
+
+	/** Returns a hash of the fields shown in the server list, used to detect rows that need rebinding */
+	uint32 GetDisplayHash() const;
+
+	/** Rebuilds Display from ServerInfo */
+	void UpdateDisplay();
+
+	/** Rebuilds only the ping text and color, for ping refreshes */
+	void UpdatePingDisplay();
+
+	/** Color bucket for a ping in milliseconds */
+	static FLinearColor GetPingColor(int32 Ping);
+
+	/** Color bucket for how full a server is */
+	static FLinearColor GetCapacityColor(int32 CurrentPlayers, int32 MaxPlayers);
+
+	/** Clears the entry before it goes back to the browser's entry pool */
+	void ResetForPool();
+};
+
+/**
+ * @struct F_ServerSearchRequest
+ * @brief A session search in flight against the subsystem that serves one source.
+ */
+struct F_ServerSearchRequest
+{
+	E_ServerSource Source;
+	TSharedRef<FOnlineSessionSearch> Search;
+
+	/** Session manager operation running the search */
+	int32 OperationId = INDEX_NONE;
 };
 
 /**
@@ -75,7 +224,10 @@ class STRAFEUI_API US_UI_VM_ServerBrowser : public US_UI_ViewModelBase
 	GENERATED_BODY()
 
 public:
-	virtual ~US_UI_VM_ServerBrowser();
+	/** Cancels searches, the pending join and tickers while the outer chain is still alive. */
+	virtual void BeginDestroy() override;
+
+	static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
 
 	/**
 	 * The list of servers to be displayed in the UI.
@@ -83,6 +235,30 @@ public:
 	UPROPERTY(BlueprintReadOnly, Category = "Server Browser")
 	TArray<F_ServerInfo> ServerList;
 
+	/** True while search results are still being converted into server entries. ServerList holds partial results meanwhile. */
+	UPROPERTY(BlueprintReadOnly, Category = "Server Browser")
+	bool bIsIngestingResults = false;
+
+	/** Number of listed entries that come from the server list cache and have not been confirmed by a live search. */
+	UPROPERTY(BlueprintReadOnly, Category = "Server Browser")
+	int32 StaleServerCount = 0;
+
+	/** Number of search results converted into server entries so far. */
+	UPROPERTY(BlueprintReadOnly, Category = "Server Browser")
+	int32 IngestedResultCount = 0;
+
+	/** Total number of search results returned so far by the searches of the last refresh. */
+	UPROPERTY(BlueprintReadOnly, Category = "Server Browser")
+	int32 TotalResultCount = 0;
+
+	/** Fired after every ingested batch of search results, including the final one. */
+	UPROPERTY(BlueprintAssignable, Category = "Server Browser")
+	FOnServerIngestionProgress OnIngestionProgress;
+
+	/** Returns the fraction of search results ingested so far, in the range [0, 1]. */
+	UFUNCTION(BlueprintPure, Category = "Server Browser")
+	float GetIngestionProgress() const;
+
 	/**
 	 * Sends a request to refresh the server list.
 	 * This would typically trigger an async call to a backend or online subsystem.
@@ -90,19 +266,94 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Server Browser")
 	void RequestServerListRefresh();
 
+	/**
+	 * Searches again while the current rows stay listed and joinable, then applies only the differences:
+	 * new servers are added, vanished ones removed and changed ones updated in place.
+	 * Falls back to RequestServerListRefresh when there are no live rows to keep. Ignored while a refresh is running.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Server Browser")
+	void RevalidateServerList();
+
+	/**
+	 * Starts or stops periodic revalidation at ServerAutoRefreshIntervalSeconds.
+	 * The interval backs off while refreshes fail or bring no changes.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Server Browser")
+	void SetAutoRefreshEnabled(bool bEnabled);
+
 	/**
 	 * Joins the selected server session.
 	 * @param SessionSearchResult The search result containing session info
+	 * @param Source The search that found the session; the join goes through the same subsystem
+	 */
+	void JoinSession(const FOnlineSessionSearchResult& SessionSearchResult, E_ServerSource Source = E_ServerSource::Online);
+
+	/**
+	 * Joins the server identified by its session key.
+	 * @param SessionKey The key from F_ServerInfo::SessionKey
+	 * @return False if no server with that key is known
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Server Browser")
+	bool JoinServer(int64 SessionKey);
+
+	/**
+	 * Joins the best server in the filtered list without a manual selection. Servers are ranked with the
+	 * Quick Join weights from US_UI_Settings; when a join fails because the server filled up or went away,
+	 * the next best one is tried.
+	 * @return False if no listed server can be joined
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Server Browser")
+	bool QuickJoin();
+
+	/** Returns the entry for the given session key, or nullptr if it is not in the current result set. O(1). */
+	US_UI_VM_ServerListEntry* FindServerEntry(int64 SessionKey) const;
+
+	/** Servers per game mode, per map and per flag across the whole list, kept current as results stream in */
+	const F_ServerFacetCounts& GetFacetCounts() const { return ServerTable.Facets; }
+
+	/** Interned game mode values; facet counts and F_ServerInfo::GameModeId index into it */
+	const F_ServerNameTable& GetGameModeNames() const { return *ServerTable.GameModeNames; }
+
+	/** Interned map values; facet counts and F_ServerInfo::MapId index into it */
+	const F_ServerNameTable& GetMapNames() const { return *ServerTable.MapNames; }
+
+	/**
+	 * Returns the detail record of a listed server, decoding it from its search result on first request.
+	 * @return False if the server is not listed or has no search result yet, as with cached entries.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Server Browser")
+	bool GetServerDetails(int64 SessionKey, F_ServerDetails& OutDetails);
+
+	/** Broadcast when a server's ping has been re-measured */
+	UPROPERTY(BlueprintAssignable, Category = "Server Browser")
+	FOnServerInfoUpdated OnServerInfoUpdated;
+
+	/**
+	 * Re-measures the ping of the given servers without running a new search.
+	 * Replaces any queries still waiting from a previous call; queries already in flight finish normally.
+	 * @param SessionKeys Keys of the servers to refresh, usually the visible rows and the selection.
 	 */
-	void JoinSession(const FOnlineSessionSearchResult& SessionSearchResult);
+	UFUNCTION(BlueprintCallable, Category = "Server Browser")
+	void RefreshServerPings(const TArray<int64>& SessionKeys);
+
+	/** Computes the stable key for a search result from its session ID */
+	static int64 MakeSessionKey(const FOnlineSessionSearchResult& SearchResult);
 
 	// Filter properties
 	UPROPERTY(BlueprintReadWrite, Category = "Server Browser|Filters")
 	FString FilterServerName;
 
+	/** Whether FilterServerName also matches server descriptions */
+	UPROPERTY(BlueprintReadWrite, Category = "Server Browser|Filters")
+	bool bFilterSearchDescriptions = false;
+
 	UPROPERTY(BlueprintReadWrite, Category = "Server Browser|Filters")
 	FString FilterGameMode;
 
+	/** Exact map name to show, or empty for every map */
+	UPROPERTY(BlueprintReadWrite, Category = "Server Browser|Filters")
+	FString FilterMapName;
+
 	UPROPERTY(BlueprintReadWrite, Category = "Server Browser|Filters")
 	bool bFilterHideFullServers = false;
 
@@ -115,37 +366,298 @@ public:
 	UPROPERTY(BlueprintReadWrite, Category = "Server Browser|Filters")
 	int32 FilterMaxPing = 999;
 
+	/** Sources searched by the next refresh */
 	UPROPERTY(BlueprintReadWrite, Category = "Server Browser|Filters")
-	bool bSearchLAN = true;
+	E_ServerSearchMode SearchMode = E_ServerSearchMode::Combined;
+
+	/** Column the visible list is sorted by */
+	UPROPERTY(BlueprintReadOnly, Category = "Server Browser|Sorting")
+	E_ServerSortColumn SortColumn = E_ServerSortColumn::None;
 
-	/** Apply current filters and refresh the displayed list */
+	/** Whether the visible list is sorted in descending order */
+	UPROPERTY(BlueprintReadOnly, Category = "Server Browser|Sorting")
+	bool bSortDescending = false;
+
+	/** Sorts the visible list by a column. Switching columns or direction reuses cached per-column orders. */
 	UFUNCTION(BlueprintCallable, Category = "Server Browser")
-	void ApplyFilters();
+	void SetSort(E_ServerSortColumn Column, bool bDescending);
 
-	// Friend class to allow FindGameWidget to access AllFoundServers
-	friend class US_UI_FindGameWidget;
+	/** Apply current filters and refresh the displayed list. Calls made within one frame are evaluated once. */
+	UFUNCTION(BlueprintCallable, Category = "Server Browser")
+	void ApplyFilters();
 
 private:
-	/** Callback for when session search completes */
-	void OnFindSessionsComplete(bool bWasSuccessful);
+	/** Returns the online subsystem that serves a source, NAME_None for the default one. LAN uses the NULL subsystem when the default one is an online backend. */
+	static FName GetSessionSubsystemName(E_ServerSource Source);
+
+	/** Returns the session interface that serves a source */
+	static IOnlineSessionPtr GetSessionInterface(E_ServerSource Source);
+
+	/** Returns the sources SearchMode asks for, skipping ones that would share a session interface with another */
+	TArray<E_ServerSource, TInlineAllocator<2>> GetSearchSources() const;
+
+	/** Starts the session search for one source and adds it to ActiveSearches. Returns false if it could not be started, including when it failed before returning. */
+	bool StartServerSearch(E_ServerSource Source, const FUniqueNetIdPtr& SearchingUserId);
+
+	/** Cancels every search in ActiveSearches with the session manager */
+	void CancelServerSearches();
+
+	/** Callback for when the session search of one source completes */
+	void OnFindSessionsComplete(const F_SessionOperationReport& Report, E_ServerSource Source);
+
+	/** Finishes the refresh once every search has completed and all results are committed */
+	void CompleteRefreshIfDone();
+
+	/** Starts a search for every source of SearchMode. Returns false, after reporting why if asked, when none could start. */
+	bool StartServerSearches(bool bReportErrors);
+
+	/** Updates a revalidated row in place from a newer result for the same server */
+	void UpdateServerEntry(int32 Row, F_ServerInfo&& ServerInfo, const F_SessionResultHandle& ResultHandle);
+
+	/** Ends a revalidation and adjusts the auto-refresh interval by whether anything changed */
+	void EndRevalidation();
+
+	/**
+	 * Revalidates with the current filters if they were widened past the query of the last search, keeping the listed rows.
+	 * Waits for a running refresh, which calls this again when it finishes.
+	 */
+	void RevalidateIfQueryOutdated();
+
+	/** Arms the auto-refresh ticker, replacing any pending one. With bBackOff the delay doubles up to the maximum. */
+	void ScheduleAutoRefresh(bool bBackOff);
+
+	/** Runs a scheduled revalidation. Always returns false so the ticker fires once. */
+	bool TickAutoRefresh(float DeltaTime);
 
 	/** Callback for when join session completes */
-	void OnJoinSessionComplete(FName SessionName, EOnJoinSessionCompleteResult::Type Result);
+	void OnJoinSessionComplete(const F_SessionOperationReport& Report, E_ServerSource Source);
+
+	/** Starts a join to the next Quick Join candidate that is still listed. Returns false once none are left. */
+	bool JoinNextQuickJoinCandidate();
+
+	/** Starts loading the package of a map named in a session's MAPNAME setting, replacing any preload of another map */
+	void StartMapPreload(const FString& MapName);
+
+	/** Drops the map preload, letting the package be collected if travel never needed it */
+	void ReleaseMapPreload();
+
+	/** Hands the map preload over to the next map load so it survives this view model being torn down by travel */
+	void KeepMapPreloadForTravel();
+
+	/** Resolves a MAPNAME setting to the map's long package name. Returns an empty string for unknown maps. */
+	static FString ResolveMapPackageName(const FString& MapName);
+
+	/**
+	 * Decodes the session settings of a search result into plain server info, interning its game mode and map.
+	 * Touches no view model state, so it is safe to call from worker threads.
+	 */
+	static void DecodeSearchResult(const FOnlineSessionSearchResult& SearchResult, F_ServerNameTable& GameModeNames, F_ServerNameTable& MapNames, F_ServerInfo& OutServerInfo);
+
+	/** Decodes the detail record of a search result. Only runs for servers the user inspects. */
+	static void DecodeServerDetails(const FOnlineSessionSearchResult& SearchResult, F_ServerDetails& OutDetails);
+
+	/** Starts decoding the results of a completed search on worker threads, one task per chunk, and queues them for commit */
+	void LaunchDecodeJob(const TSharedRef<FOnlineSessionSearch>& Search, int32 SearchIndex, E_ServerSource Source);
+
+	/** Commits one decoded result as a server entry, replacing any cached entry for the same server */
+	void CommitDecodedServer(F_ServerInfo&& ServerInfo, F_ServerRowText&& RowText, const F_SessionResultHandle& ResultHandle);
+
+	/** Appends an entry to AllFoundServers, ServerIndexByKey and ServerTable */
+	void AddServerEntry(US_UI_VM_ServerListEntry* Entry);
+
+	/** Appends an entry whose table text was already lowercased */
+	void AddServerEntry(US_UI_VM_ServerListEntry* Entry, F_ServerRowText&& RowText);
+
+	/** Moves every entry out of AllFoundServers into RetiredEntries and clears the derived lists */
+	void RetireServerEntries();
+
+	/** Returns retired entries to the pool. Call only after the view has been told the entries are gone. */
+	void ReleaseRetiredEntries();
+
+	/** Shows the servers from the on-disk cache as stale entries */
+	void LoadCachedServers();
+
+	/** Writes the current live servers to the on-disk cache in the background */
+	void SaveCachedServers() const;
+
+	/**
+	 * Drops cached rows, both replaced and unconfirmed, along with revalidated rows that were replaced
+	 * or that no search confirmed, then rebuilds the table from the remaining rows.
+	 * @return The number of servers that went away.
+	 */
+	int32 RemoveUnconfirmedRows();
+
+	/** Commits decoded results until the frame budget is spent. Returns false once ingestion is done. */
+	bool TickIngestion(float DeltaTime);
+
+	/**
+	 * Commits decoded results in search order, then in result order, until the budget is spent
+	 * or the next result's chunk is still being decoded.
+	 * @return The number of results committed.
+	 */
+	int32 IngestBatch(double BudgetSeconds);
+
+	/** Finalizes ingestion once every search result has been committed */
+	void FinishIngestion();
 
-	/** Active session search object */
-	TSharedPtr<FOnlineSessionSearch> SessionSearch;
+	/** Cancels any in-progress ingestion */
+	void StopIngestion();
+
+	/** Starts queued ping queries until the concurrency limit is reached */
+	void StartPingQueries();
+
+	/** Callback for a single ping query */
+	void OnPingQueryComplete(const F_SessionOperationReport& Report, int64 SessionKey);
+
+	/** Applies a re-measured ping to the entry, the table and the visible list */
+	void UpdateServerPing(int64 SessionKey, int32 Ping);
+
+	/** Servers waiting for a ping query */
+	TArray<int64> PendingPingQueries;
+
+	/** Servers with a ping query in flight, and the session operation running it */
+	TMap<int64, int32> ActivePingQueries;
+
+	/** True while StartPingQueries is issuing queries */
+	bool bStartingPingQueries = false;
+
+	/** Session searches of the current refresh that have not completed yet, at most one per source */
+	TArray<F_ServerSearchRequest> ActiveSearches;
+
+	/** True if a search of the current refresh failed, in which case cached servers are not dropped for lack of results */
+	bool bAnySearchFailed = false;
+
+	/** True while StartServerSearches is submitting searches */
+	bool bStartingSearches = false;
+
+	/** Filters the searches were sent with; servers they reject were never downloaded */
+	F_ServerSearchQuery SearchQuery;
+
+	/** Owns the results of completed searches; entries refer into it by handle */
+	F_SessionResultArena ResultArena;
+
+	/** Completed searches whose results are being decoded off the game thread, in commit order */
+	TArray<TSharedPtr<F_ServerDecodeJob>> DecodeJobs;
+
+	/** Ticker used to spread result ingestion over several frames */
+	FTSTicker::FDelegateHandle IngestionTickerHandle;
 
 	/** Cached list of all found servers before filtering */
 	UPROPERTY()
 	TArray<TObjectPtr<US_UI_VM_ServerListEntry>> AllFoundServers;
 
-	/** Delegate handles for cleanup */
-	FDelegateHandle FindSessionsCompleteDelegateHandle;
-	FDelegateHandle JoinSessionCompleteDelegateHandle;
+	/** Entries no longer listed, waiting for the view to drop them before they are reused */
+	UPROPERTY()
+	TArray<TObjectPtr<US_UI_VM_ServerListEntry>> RetiredEntries;
+
+	/** Recycles server entries between refreshes */
+	TS_UI_ObjectPool<US_UI_VM_ServerListEntry> EntryPool;
+
+	/** Maps a session key to its index in AllFoundServers */
+	TMap<int64, int32> ServerIndexByKey;
+
+	/** Detail records decoded so far, by session key. Dropped when the server's search result is replaced. */
+	TMap<int64, F_ServerDetails> ServerDetailsByKey;
+
+	/** Column-oriented copy of AllFoundServers used for filtering. Rows match AllFoundServers indices. */
+	F_ServerTable ServerTable;
+
+	/** One bit per row of ServerTable, set for rows that pass the current filters */
+	TArray<uint32> ServerSelection;
+
+	/** ServerTable row of each ServerList entry */
+	TArray<int32> ServerListRows;
+
+	/** Cached rows replaced by live results during the current batch */
+	TArray<int32> SupersededRows;
+
+	/** True while ServerTable still contains rows loaded from the cache */
+	bool bHasCachedRows = false;
+
+	/** True while a revalidation runs; existing rows stay listed until the searches confirm or drop them */
+	bool bIsRevalidating = false;
+
+	/** One bit per row that existed when the revalidation started, set until a search reports that server again */
+	TBitArray<> UnconfirmedRows;
+
+	/** First arena search of the running revalidation; earlier searches are released once it completes */
+	int32 FirstRevalidationSearch = 0;
 
-	/** Updates the visible server list based on current filters */
+	/** Servers added, removed or changed by the running revalidation */
+	int32 RevalidationChangeCount = 0;
+
+	/** Set when revalidated rows changed whether they pass the filters, so the list is rebuilt after the batch */
+	bool bRebuildServerListPending = false;
+
+	/** Whether SetAutoRefreshEnabled turned auto-refresh on */
+	bool bAutoRefreshEnabled = false;
+
+	/** Seconds until the next auto-refresh, including backoff */
+	float AutoRefreshDelay = 0.0f;
+
+	/** Ticker that fires the next auto-refresh */
+	FTSTicker::FDelegateHandle AutoRefreshTickerHandle;
+
+	/** Session keys Quick Join has not tried yet, best first */
+	TArray<int64> QuickJoinCandidates;
+
+	/** True while joins are being attempted on behalf of QuickJoin */
+	bool bIsQuickJoining = false;
+
+	/** Session manager operation of the join in flight */
+	int32 JoinOperationId = INDEX_NONE;
+
+	/** Async load of the destination map started alongside the session join */
+	TSharedPtr<FStreamableHandle> MapPreloadHandle;
+
+	/** Long package name MapPreloadHandle is loading */
+	FString MapPreloadPackageName;
+
+	/** Filters that ServerSelection and ServerList currently reflect */
+	F_ServerFilterState AppliedFilter;
+
+	/** Ticker used to debounce ApplyFilters to one evaluation per frame */
+	FTSTicker::FDelegateHandle FilterTickerHandle;
+
+	/** Runs the pending filter evaluation. Always returns false so the ticker fires once. */
+	bool TickFilters(float DeltaTime);
+
+	/** Updates the visible server list based on current filters, re-evaluating only the rows the change can affect */
 	void UpdateFilteredServerList();
 
-	/** Checks if a server passes the current filter criteria */
-	bool PassesFilters(const TObjectPtr<US_UI_VM_ServerListEntry>& Entry) const;
+	/** Appends entries from AllFoundServers starting at FirstIndex that pass the applied filters to ServerList */
+	void AppendFilteredServers(int32 FirstIndex);
+
+	/** Rebuilds ServerList from the selection bitmap in the current sort order */
+	void RebuildServerList();
+
+	/** Inserts a newly selected row into ServerList where the current sort order puts it */
+	void InsertFilteredServer(int32 Row);
+
+	/** Empties ServerList and its row mapping */
+	void ClearServerList();
+
+	/** Removes ServerList entries whose rows are no longer selected, keeping the order of the rest */
+	void CompactServerList();
+
+	/** Re-evaluates only the visible rows after a narrowing change */
+	void NarrowFilteredServers();
+
+	/** Re-evaluates only the rejected rows after a widening change */
+	void WidenFilteredServers();
+
+	/** Clears selection bits from FirstIndex on for rows the trigram index rules out for the name query */
+	void RestrictToNameCandidates(int32 FirstIndex);
+
+	/** Snapshots the filter properties */
+	F_ServerFilterState MakeFilterState() const;
+
+	/** Picks the filters the backend can evaluate */
+	F_ServerSearchQuery MakeSearchQuery() const;
+
+	/** Checks every applied filter for a single row */
+	bool PassesFilters(int32 Row) const;
+
+	/** Checks the applied text filters for a row */
+	bool PassesTextFilters(int32 Row) const;
 };
\ No newline at end of file
@@ -58,4 +58,8 @@ public:
 	 */
 	UPROPERTY(BlueprintAssignable, Category = "ViewModel")
 	FOnDataChanged OnDataChanged;
+
+protected:
+	/** Gets the session manager of the UI subsystem, or null if there is no game instance yet. */
+	class US_UI_OnlineSessionManager* GetSessionManager() const;
 };
\ No newline at end of file